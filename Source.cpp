@@ -6,17 +6,247 @@
 #include <random>
 #include <chrono>
 #include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace std::chrono;
 
+// ============================================================================
+// MEMORY BUDGET GOVERNOR
+// ============================================================================
+// Process-wide budget for sorting scratch memory. Sorters reserve their
+// scratch before allocating it; when the reservation is refused they
+// downgrade to an in-place variant, which in turn waits (queues) for its much
+// smaller reservation. A limit of 0 means unlimited, which is the default.
+class MemoryBudget {
+public:
+    static MemoryBudget& instance() {
+        static MemoryBudget budget;
+        return budget;
+    }
+
+    void setLimit(size_t bytes) {
+        lock_guard<mutex> lock(budgetMutex);
+        limitBytes = bytes;
+        budgetReleased.notify_all();
+    }
+
+    // Grant the reservation only if it fits under the limit right now
+    bool tryReserve(size_t bytes) {
+        lock_guard<mutex> lock(budgetMutex);
+        if (!fits(bytes)) return false;
+        grant(bytes);
+        return true;
+    }
+
+    // Wait until the reservation fits. A request larger than the whole limit
+    // is granted once nothing else is reserved, so it cannot wait forever.
+    void reserve(size_t bytes) {
+        unique_lock<mutex> lock(budgetMutex);
+        budgetReleased.wait(lock, [&] { return fits(bytes) || reservedBytes == 0; });
+        grant(bytes);
+    }
+
+    void release(size_t bytes) {
+        {
+            lock_guard<mutex> lock(budgetMutex);
+            reservedBytes -= bytes;
+        }
+        budgetReleased.notify_all();
+    }
+
+    void recordDowngrade() { downgrades++; }
+    size_t downgradeCount() const { return downgrades.load(); }
+
+    size_t peakReservedBytes() {
+        lock_guard<mutex> lock(budgetMutex);
+        return peakBytes;
+    }
+
+    void resetStatistics() {
+        lock_guard<mutex> lock(budgetMutex);
+        peakBytes = reservedBytes;
+        downgrades = 0;
+    }
+
+private:
+    MemoryBudget() {}
+
+    bool fits(size_t bytes) const {
+        return limitBytes == 0 || reservedBytes + bytes <= limitBytes;
+    }
+
+    void grant(size_t bytes) {
+        reservedBytes += bytes;
+        peakBytes = max(peakBytes, reservedBytes);
+    }
+
+    mutex budgetMutex;
+    condition_variable budgetReleased;
+    size_t limitBytes = 0;
+    size_t reservedBytes = 0;
+    size_t peakBytes = 0;
+    atomic<size_t> downgrades{ 0 };
+};
+
+// RAII reservation against MemoryBudget::instance(); released on destruction
+class ScratchReservation {
+public:
+    // waitForBudget = false: try once, check granted()
+    // waitForBudget = true:  queue until the budget allows it (always granted)
+    ScratchReservation(size_t requestedBytes, bool waitForBudget) : bytes(requestedBytes), isGranted(true) {
+        if (waitForBudget) MemoryBudget::instance().reserve(bytes);
+        else isGranted = MemoryBudget::instance().tryReserve(bytes);
+    }
+
+    ~ScratchReservation() {
+        if (isGranted) MemoryBudget::instance().release(bytes);
+    }
+
+    ScratchReservation(const ScratchReservation&) = delete;
+    ScratchReservation& operator=(const ScratchReservation&) = delete;
+
+    bool granted() const { return isGranted; }
+
+private:
+    size_t bytes;
+    bool isGranted;
+};
+
+// Downgrade target for the out-of-place stable sorts below; defined in the
+// "RADIX SORT (STABLE, IN-PLACE WITH SUBLINEAR BUFFER)" section
+template<typename Record, typename KeyFunction>
+void stableRadixSortInPlace(vector<Record>& records, KeyFunction keyOf, size_t bufferSize = 0);
+inline uint32_t radixKeyOf(int value);
+
+// Comparison fallback when no key-extraction downgrade applies; defined in
+// the "PARALLEL STABLE MERGE SORT (MERGE PATH)" section
+template<typename Iterator, typename Compare>
+void stableSortInPlace(Iterator first, Iterator last, Compare less);
+
+// Scratch needed by stableRadixSortInPlace with its default buffer
+inline size_t inPlaceRadixScratchBytes(size_t n, size_t recordBytes = sizeof(int)) {
+    return max<size_t>(256, static_cast<size_t>(sqrt(static_cast<double>(n)))) * recordBytes + 256 * sizeof(int);
+}
+
+// Output order for the engines that can sort both ways without a reverse pass
+enum SortOrder { ASCENDING, DESCENDING };
+
+// Run the stable in-place radix sort as the budget-constrained fallback
+template<typename Record, typename KeyFunction>
+void downgradeToInPlaceRadix(vector<Record>& records, KeyFunction keyOf) {
+    MemoryBudget::instance().recordDowngrade();
+    ScratchReservation scratch(inPlaceRadixScratchBytes(records.size(), sizeof(Record)), true);
+    stableRadixSortInPlace(records, keyOf);
+}
+
+inline void downgradeToInPlaceRadix(vector<int>& array, SortOrder order = ASCENDING) {
+    if (order == DESCENDING) downgradeToInPlaceRadix(array, [](int value) { return ~radixKeyOf(value); });
+    else downgradeToInPlaceRadix(array, [](int value) { return radixKeyOf(value); });
+}
+
+// ============================================================================
+// TUNING PROFILE
+// ============================================================================
+// Machine-specific thresholds used by the engines. The defaults reproduce the
+// untuned behaviour; `./sorting_demo --autotune` measures better values on the
+// host and writes them to the profile file, which is loaded on first use.
+// File format: one "name = value" per line; unknown names are ignored.
+// The path is taken from SORTING_TUNING_PROFILE, else the default below.
+const char* const DEFAULT_TUNING_PROFILE_PATH = "sorting_tuning.profile";
+
+struct TuningProfile {
+    size_t bucketInsertionCutoff = numeric_limits<size_t>::max(); // bucketSort: larger buckets use std::sort
+    int bucketLoadFactor = 1;              // bucketSort: target elements per bucket
+    size_t learnedInsertionCutoff = 64;    // bucketSortLearnedCDF: same cutoff
+    int learnedBucketLoadFactor = 4;       // bucketSortLearnedCDF: elements per bucket
+    int radixDigitBits = 8;                // radixSortByteLSD: default digit width
+    double countingRangeFactor = 2.0;      // sortBatch: counting sort while range < factor * n
+};
+
+string tuningProfilePath() {
+    const char* path = getenv("SORTING_TUNING_PROFILE");
+    return path != nullptr ? string(path) : string(DEFAULT_TUNING_PROFILE_PATH);
+}
+
+// Missing files and malformed lines leave the defaults in place
+TuningProfile loadTuningProfile(const string& path) {
+    TuningProfile profile;
+    ifstream input(path);
+    string line;
+    while (getline(input, line)) {
+        size_t separator = line.find('=');
+        if (line.empty() || line[0] == '#' || separator == string::npos) continue;
+        string name = line.substr(0, separator);
+        name.erase(name.find_last_not_of(" \t") + 1);
+        istringstream value(line.substr(separator + 1));
+        if (name == "bucketInsertionCutoff") value >> profile.bucketInsertionCutoff;
+        else if (name == "bucketLoadFactor") value >> profile.bucketLoadFactor;
+        else if (name == "learnedInsertionCutoff") value >> profile.learnedInsertionCutoff;
+        else if (name == "learnedBucketLoadFactor") value >> profile.learnedBucketLoadFactor;
+        else if (name == "radixDigitBits") value >> profile.radixDigitBits;
+        else if (name == "countingRangeFactor") value >> profile.countingRangeFactor;
+    }
+    profile.bucketLoadFactor = max(1, profile.bucketLoadFactor);
+    profile.learnedBucketLoadFactor = max(1, profile.learnedBucketLoadFactor);
+    profile.radixDigitBits = max(1, min(16, profile.radixDigitBits));
+    return profile;
+}
+
+bool saveTuningProfile(const TuningProfile& profile, const string& path) {
+    ofstream output(path, ios::trunc);
+    output << "# Generated by ./sorting_demo --autotune" << endl;
+    output << "bucketInsertionCutoff = " << profile.bucketInsertionCutoff << endl;
+    output << "bucketLoadFactor = " << profile.bucketLoadFactor << endl;
+    output << "learnedInsertionCutoff = " << profile.learnedInsertionCutoff << endl;
+    output << "learnedBucketLoadFactor = " << profile.learnedBucketLoadFactor << endl;
+    output << "radixDigitBits = " << profile.radixDigitBits << endl;
+    output << "countingRangeFactor = " << profile.countingRangeFactor << endl;
+    return static_cast<bool>(output);
+}
+
+// Process-wide profile, loaded from tuningProfilePath() on first use
+TuningProfile& tuningProfile() {
+    static TuningProfile profile = loadTuningProfile(tuningProfilePath());
+    return profile;
+}
+
 // ============================================================================
 // COUNTING SORT (STABLE VERSION)
 // ============================================================================
 // Time Complexity: O(n + k) where k is the range of input
 // Space Complexity: O(n + k)
 // Stability: Yes - maintains relative order of equal elements
-void countingSortStable(vector<int>& array) {
+// Descending order accumulates the counts from the top value down instead.
+void countingSortStableOrdered(vector<int>& array, SortOrder order) {
     if (array.empty()) return;
 
     // Find the range of input elements
@@ -24,6 +254,13 @@ void countingSortStable(vector<int>& array) {
     int maxValue = *max_element(array.begin(), array.end());
     int range = maxValue - minValue + 1;
 
+    // Reserve the count and output arrays; downgrade if the budget is short
+    ScratchReservation scratch((static_cast<size_t>(range) + array.size()) * sizeof(int), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array, order);
+        return;
+    }
+
     // Count occurrences of each element
     vector<int> countArray(range, 0);
     for (int value : array) {
@@ -32,8 +269,15 @@ void countingSortStable(vector<int>& array) {
 
     // Transform count array to store cumulative positions
     // This enables stable sorting by placing elements from right to left
-    for (int i = 1; i < range; i++) {
-        countArray[i] += countArray[i - 1];
+    if (order == DESCENDING) {
+        for (int i = range - 2; i >= 0; i--) {
+            countArray[i] += countArray[i + 1];
+        }
+    }
+    else {
+        for (int i = 1; i < range; i++) {
+            countArray[i] += countArray[i - 1];
+        }
     }
 
     // Build output array by placing elements in correct positions
@@ -50,6 +294,14 @@ void countingSortStable(vector<int>& array) {
     array = outputArray;
 }
 
+void countingSortStable(vector<int>& array) {
+    countingSortStableOrdered(array, ASCENDING);
+}
+
+void countingSortStableDescending(vector<int>& array) {
+    countingSortStableOrdered(array, DESCENDING);
+}
+
 // ============================================================================
 // COUNTING SORT (NON-STABLE VERSION)
 // ============================================================================
@@ -64,6 +316,13 @@ void countingSortNonStable(vector<int>& array) {
     int maxValue = *max_element(array.begin(), array.end());
     int range = maxValue - minValue + 1;
 
+    // Reserve the count array; downgrade if the budget is short
+    ScratchReservation scratch(static_cast<size_t>(range) * sizeof(int), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array);
+        return;
+    }
+
     // Count occurrences of each element
     vector<int> countArray(range, 0);
     for (int value : array) {
@@ -81,15 +340,76 @@ void countingSortNonStable(vector<int>& array) {
     }
 }
 
+// ============================================================================
+// COUNTING SORT (FULL 8/16-BIT DOMAIN)
+// ============================================================================
+// Time Complexity: O(n + 2^bits), with no min/max scan
+// Space Complexity: O(lanes * 2^bits) - 4 KB for bytes, 256 KB for shorts;
+//                   beyond 2^30 keys add 64-bit totals (2 KB / 512 KB)
+// Stability: No - keys are rewritten from the histogram
+// Best for: uint8_t/int8_t/uint16_t/int16_t data, where the whole key domain
+//           fits in an L1/L2-resident histogram
+// Runs of equal bytes make one counter the bottleneck (each increment waits
+// for the previous store), so 8-bit keys count into 4 interleaved lanes that
+// are summed afterwards. 16-bit keys use a single lane so the histogram stays
+// in L2. The rewrite is one fill_n per key value, which becomes a memset for
+// bytes and a vectorised store loop for shorts.
+template<typename Small>
+void countingSortFullDomain(vector<Small>& array) {
+    static_assert(is_integral<Small>::value && sizeof(Small) <= 2,
+        "countingSortFullDomain needs an 8-bit or 16-bit integer key");
+    typedef typename make_unsigned<Small>::type Index;
+    const size_t DOMAIN = size_t(1) << (8 * sizeof(Small));
+    const size_t LANES = sizeof(Small) == 1 ? 4 : 1;
+    const Small lowest = numeric_limits<Small>::min();
+    if (array.size() < 2) return;
+
+    // 32-bit lane counters. Up to 2^30 keys are one block and are emitted
+    // from lane 0; longer arrays flush every block into 64-bit totals so no
+    // counter overflows
+    const size_t BLOCK = size_t(1) << 30;
+    vector<size_t> totals(array.size() > BLOCK ? DOMAIN : 0, 0);
+    vector<uint32_t> laneCounts(LANES * DOMAIN);
+    for (size_t blockStart = 0; blockStart < array.size(); blockStart += BLOCK) {
+        size_t blockEnd = min(array.size(), blockStart + BLOCK);
+        fill(laneCounts.begin(), laneCounts.end(), 0);
+        uint32_t* counts = laneCounts.data();
+        const Small* data = array.data();
+        size_t i = blockStart;
+        if (LANES == 4) {
+            for (; i + 4 <= blockEnd; i += 4) {
+                counts[static_cast<Index>(data[i] - lowest)]++;
+                counts[DOMAIN + static_cast<Index>(data[i + 1] - lowest)]++;
+                counts[2 * DOMAIN + static_cast<Index>(data[i + 2] - lowest)]++;
+                counts[3 * DOMAIN + static_cast<Index>(data[i + 3] - lowest)]++;
+            }
+        }
+        for (; i < blockEnd; i++) counts[static_cast<Index>(data[i] - lowest)]++;
+        for (size_t lane = 1; lane < LANES; lane++) {
+            for (size_t key = 0; key < DOMAIN; key++) counts[key] += counts[lane * DOMAIN + key];
+        }
+        if (!totals.empty()) {
+            for (size_t key = 0; key < DOMAIN; key++) totals[key] += counts[key];
+        }
+    }
+
+    Small* output = array.data();
+    for (size_t key = 0; key < DOMAIN; key++) {
+        size_t keyCount = totals.empty() ? laneCounts[key] : totals[key];
+        output = fill_n(output, keyCount, static_cast<Small>(key + lowest));
+    }
+}
+
 // ============================================================================
 // RADIX SORT (LSD - Least Significant Digit)
 // ============================================================================
 // Time Complexity: O(d * (n + b)) where d is number of digits, b is base
 // Space Complexity: O(n + b)
 // Stability: Yes - relies on stable counting sort for each digit
+// Descending order only changes the direction of each digit's cumulative count.
 
 // Helper function: performs counting sort on a specific digit position
-void countingSortByDigit(vector<int>& array, int digitPosition) {
+void countingSortByDigit(vector<int>& array, int digitPosition, SortOrder order = ASCENDING) {
     if (array.empty()) return; // IMPORTANT: Check for empty array
 
     const int BASE = 10; // Decimal number system
@@ -103,8 +423,15 @@ void countingSortByDigit(vector<int>& array, int digitPosition) {
     }
 
     // Transform to cumulative count for positioning
-    for (int i = 1; i < BASE; i++) {
-        countArray[i] += countArray[i - 1];
+    if (order == DESCENDING) {
+        for (int i = BASE - 2; i >= 0; i--) {
+            countArray[i] += countArray[i + 1];
+        }
+    }
+    else {
+        for (int i = 1; i < BASE; i++) {
+            countArray[i] += countArray[i - 1];
+        }
     }
 
     // Build output array maintaining stability (right to left)
@@ -121,18 +448,607 @@ void countingSortByDigit(vector<int>& array, int digitPosition) {
 }
 
 // Main radix sort function (LSD approach)
-void radixSortLSD(vector<int>& array) {
+void radixSortLSDOrdered(vector<int>& array, SortOrder order) {
     if (array.empty()) return;
 
+    // Reserve the per-pass output array; downgrade if the budget is short
+    ScratchReservation scratch(array.size() * sizeof(int), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array, order);
+        return;
+    }
+
     // Find maximum value to determine number of digits
     int maxValue = *max_element(array.begin(), array.end());
 
     // Process each digit position from least to most significant
     // digitPosition represents 10^0, 10^1, 10^2, etc.
-    for (int digitPosition = 1; maxValue / digitPosition > 0; digitPosition *= 10) {
-        countingSortByDigit(array, digitPosition);
+    // (long long so the step past 10^9 cannot overflow for keys near INT_MAX)
+    for (long long digitPosition = 1; maxValue / digitPosition > 0; digitPosition *= 10) {
+        countingSortByDigit(array, static_cast<int>(digitPosition), order);
+    }
+}
+
+void radixSortLSD(vector<int>& array) {
+    radixSortLSDOrdered(array, ASCENDING);
+}
+
+void radixSortLSDDescending(vector<int>& array) {
+    radixSortLSDOrdered(array, DESCENDING);
+}
+
+// ============================================================================
+// RADIX SORT (BYTE-WISE LSD ENGINE)
+// ============================================================================
+// Time Complexity: O(p * (n + b)) where p is the number of digits, b = 2^bits
+// Space Complexity: O(n + b * p)
+// Stability: Yes - every pass is a stable counting scatter
+// Works on any record type; keyOf maps a record to an unsigned integer key
+// (use radixKeyOf for signed ints). Passes whose digit is identical for every
+// key are skipped, so small-range keys cost fewer than p passes.
+// Digits are one byte unless digitBits or the tuning profile says otherwise.
+// For descending order pass a complemented key (radixKeyOfDescending); the
+// sort stays stable and costs the same, unlike sorting and then reversing.
+
+// Map a signed key to an unsigned key with the same ordering (flip sign bit)
+inline uint32_t radixKeyOf(int value) {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+// Key that sorts ints from largest to smallest
+inline uint32_t radixKeyOfDescending(int value) {
+    return ~radixKeyOf(value);
+}
+
+// The passes themselves; callers that already hold a reservation for the
+// buffer use this directly so they never queue on the budget twice
+template<typename Record, typename KeyFunction>
+void radixSortByteLSDUnbudgeted(vector<Record>& records, KeyFunction keyOf, int digitBits = 0) {
+    if (records.size() < 2) return;
+
+    typedef decltype(keyOf(records.front())) Key;
+    if (digitBits <= 0) digitBits = tuningProfile().radixDigitBits;
+    const int BASE = 1 << digitBits;
+    const Key MASK = static_cast<Key>(BASE - 1);
+    const int PASSES = (8 * static_cast<int>(sizeof(Key)) + digitBits - 1) / digitBits;
+
+    // A single read pass builds the histogram of every digit position
+    vector<size_t> countArray(PASSES * BASE, 0);
+    for (const Record& record : records) {
+        Key key = keyOf(record);
+        for (int pass = 0; pass < PASSES; pass++) {
+            countArray[pass * BASE + static_cast<size_t>((key >> (digitBits * pass)) & MASK)]++;
+        }
+    }
+
+    vector<Record> buffer(records.size());
+    for (int pass = 0; pass < PASSES; pass++) {
+        size_t* count = &countArray[pass * BASE];
+        size_t firstDigit = static_cast<size_t>((keyOf(records.front()) >> (digitBits * pass)) & MASK);
+        if (count[firstDigit] == records.size()) continue;
+
+        // Exclusive prefix sum turns counts into starting offsets
+        size_t offset = 0;
+        for (int digit = 0; digit < BASE; digit++) {
+            size_t digitCount = count[digit];
+            count[digit] = offset;
+            offset += digitCount;
+        }
+
+        // Scatter left to right; equal digits keep their relative order
+        for (const Record& record : records) {
+            size_t digit = static_cast<size_t>((keyOf(record) >> (digitBits * pass)) & MASK);
+            buffer[count[digit]++] = record;
+        }
+        records.swap(buffer);
+    }
+}
+
+template<typename Record, typename KeyFunction>
+void radixSortByteLSD(vector<Record>& records, KeyFunction keyOf, int digitBits = 0) {
+    if (records.size() < 2) return;
+
+    // Reserve the scatter buffer; downgrade if the budget is short
+    ScratchReservation scratch(records.size() * sizeof(Record), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(records, keyOf);
+        return;
+    }
+    radixSortByteLSDUnbudgeted(records, keyOf, digitBits);
+}
+
+// ============================================================================
+// BITSET SORT (DENSE UNIQUE KEYS)
+// ============================================================================
+// Time Complexity: O(n + k/64) where k is the range of input
+// Space Complexity: O(k/64) words - one bit per possible value, 32x less
+//                   than the int count array of countingSortNonStable
+// Stability: Not applicable - keys must be distinct
+// Best for: Sets of distinct IDs that cover a dense range (row ids, vertex
+//           ids, allocated handles)
+// The bitset is used only while the range is at most BITSET_RANGE_FACTOR * n,
+// so it never exceeds twice the array's own size. Keys set their bits without
+// branching. A total popcount below n means some key repeated. Sparse ranges,
+// duplicates and a refused memory budget all fall back to the byte radix
+// sort with the array untouched. Emission walks each word's set bits with tzcnt.
+const uint64_t BITSET_RANGE_FACTOR = 64;
+
+inline int trailingZeroCount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+inline int populationCount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word; word &= word - 1) count++;
+    return count;
+#endif
+}
+
+// Returns true if the bitset path sorted the array, false if the input was
+// too sparse or had duplicates and went to radixSortByteLSD instead
+bool bitsetSort(vector<int>& array) {
+    if (array.size() < 2) return true;
+    auto radixFallback = [&]() {
+        radixSortByteLSD(array, [](int value) { return radixKeyOf(value); });
+        return false;
+    };
+
+    int minValue = *min_element(array.begin(), array.end());
+    int maxValue = *max_element(array.begin(), array.end());
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(maxValue) - minValue) + 1;
+
+    // More keys than values guarantees a duplicate; a sparse range would
+    // make the bitset larger than the keys themselves
+    if (range < array.size() || range > BITSET_RANGE_FACTOR * array.size()) return radixFallback();
+
+    size_t wordCount = static_cast<size_t>((range + 63) / 64);
+    ScratchReservation scratch(wordCount * sizeof(uint64_t), false);
+    if (!scratch.granted()) return radixFallback();
+    vector<uint64_t> words(wordCount, 0);
+    for (int value : array) {
+        uint64_t offset = static_cast<uint64_t>(static_cast<int64_t>(value) - minValue);
+        words[offset >> 6] |= 1ULL << (offset & 63);
+    }
+
+    size_t distinct = 0;
+    for (uint64_t word : words) distinct += populationCount64(word);
+    if (distinct != array.size()) return radixFallback();
+
+    size_t arrayIndex = 0;
+    for (size_t w = 0; w < words.size(); w++) {
+        int64_t base = static_cast<int64_t>(minValue) + 64 * static_cast<int64_t>(w);
+        for (uint64_t word = words[w]; word; word &= word - 1) {
+            array[arrayIndex++] = static_cast<int>(base + trailingZeroCount64(word));
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// RADIX SORT (STABLE, IN-PLACE WITH SUBLINEAR BUFFER)
+// ============================================================================
+// Time Complexity: O(p * n * log(n / B)) where B is the buffer size
+// Space Complexity: O(B + 256), B defaults to sqrt(n) - no n-sized output array
+// Stability: Yes - every step is a stable scatter or a stable merge
+// Best for: Stable multi-key sorting when an n-sized scratch array is too much
+// Each byte pass stably sorts by that byte: blocks of B records are sorted by
+// counting-scatter through the buffer, then neighbouring blocks are merged in
+// place. A merge copies the shorter run into the buffer when it fits and
+// otherwise splits both runs and swaps the middle parts with a rotation.
+template<typename Record, typename KeyFunction>
+void mergeByDigitInPlace(Record* first, Record* middle, Record* last, int shift,
+    KeyFunction keyOf, vector<Record>& buffer) {
+    auto digitOf = [&](const Record& record) {
+        return static_cast<unsigned>((keyOf(record) >> shift) & 0xFF);
+    };
+    size_t leftSize = middle - first;
+    size_t rightSize = last - middle;
+    if (leftSize == 0 || rightSize == 0) return;
+    if (digitOf(*(middle - 1)) <= digitOf(*middle)) return;
+
+    // Buffered merge, front to back: ties are taken from the left run
+    if (leftSize <= buffer.size()) {
+        copy(first, middle, buffer.begin());
+        Record* left = buffer.data();
+        Record* leftEnd = left + leftSize;
+        Record* right = middle;
+        Record* output = first;
+        while (left != leftEnd && right != last) {
+            if (digitOf(*right) < digitOf(*left)) *output++ = *right++;
+            else *output++ = *left++;
+        }
+        copy(left, leftEnd, output);
+        return;
+    }
+
+    // Buffered merge, back to front: ties are taken from the right run
+    if (rightSize <= buffer.size()) {
+        copy(middle, last, buffer.begin());
+        Record* left = middle;
+        Record* right = buffer.data() + rightSize;
+        Record* output = last;
+        while (left != first && right != buffer.data()) {
+            if (digitOf(*(left - 1)) > digitOf(*(right - 1))) *--output = *--left;
+            else *--output = *--right;
+        }
+        copy(buffer.data(), right, output - (right - buffer.data()));
+        return;
+    }
+
+    // Rotation merge: cut the longer run in half, find the matching cut in the
+    // other run, rotate the two middle parts together and merge each side
+    Record* leftCut;
+    Record* rightCut;
+    if (leftSize >= rightSize) {
+        leftCut = first + leftSize / 2;
+        unsigned cutDigit = digitOf(*leftCut);
+        rightCut = partition_point(middle, last, [&](const Record& record) { return digitOf(record) < cutDigit; });
+    }
+    else {
+        rightCut = middle + rightSize / 2;
+        unsigned cutDigit = digitOf(*rightCut);
+        leftCut = partition_point(first, middle, [&](const Record& record) { return digitOf(record) <= cutDigit; });
+    }
+    Record* newMiddle = leftCut + (rightCut - middle);
+    rotate(leftCut, middle, rightCut);
+    mergeByDigitInPlace(first, leftCut, newMiddle, shift, keyOf, buffer);
+    mergeByDigitInPlace(newMiddle, rightCut, last, shift, keyOf, buffer);
+}
+
+template<typename Record, typename KeyFunction>
+void stableRadixSortInPlace(vector<Record>& records, KeyFunction keyOf, size_t bufferSize) {
+    size_t n = records.size();
+    if (n < 2) return;
+
+    typedef decltype(keyOf(records.front())) Key;
+    const int BASE = 256;
+    const int PASSES = sizeof(Key);
+    if (bufferSize == 0) {
+        bufferSize = max<size_t>(BASE, static_cast<size_t>(sqrt(static_cast<double>(n))));
+    }
+    bufferSize = min(bufferSize, n);
+    vector<Record> buffer(bufferSize);
+    Record* data = records.data();
+
+    // Bytes on which every key agrees need no pass
+    Key allOnes = keyOf(records.front());
+    Key allZeros = allOnes;
+    for (const Record& record : records) {
+        allOnes &= keyOf(record);
+        allZeros |= keyOf(record);
+    }
+    Key varyingBits = allOnes ^ allZeros;
+
+    for (int pass = 0; pass < PASSES; pass++) {
+        int shift = 8 * pass;
+        if (((varyingBits >> shift) & 0xFF) == 0) continue;
+
+        // Sort each buffer-sized block by this byte with a counting scatter
+        for (size_t blockStart = 0; blockStart < n; blockStart += bufferSize) {
+            size_t blockEnd = min(n, blockStart + bufferSize);
+            size_t countArray[BASE + 1] = { 0 };
+            for (size_t i = blockStart; i < blockEnd; i++) {
+                countArray[((keyOf(data[i]) >> shift) & 0xFF) + 1]++;
+            }
+            for (int digit = 1; digit <= BASE; digit++) {
+                countArray[digit] += countArray[digit - 1];
+            }
+            for (size_t i = blockStart; i < blockEnd; i++) {
+                buffer[countArray[(keyOf(data[i]) >> shift) & 0xFF]++] = data[i];
+            }
+            copy(buffer.begin(), buffer.begin() + (blockEnd - blockStart), data + blockStart);
+        }
+
+        // Bottom-up stable merging of the sorted blocks
+        for (size_t width = bufferSize; width < n; width *= 2) {
+            for (size_t first = 0; first + width < n; first += 2 * width) {
+                mergeByDigitInPlace(data + first, data + first + width, data + min(n, first + 2 * width),
+                    shift, keyOf, buffer);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// PARALLEL IN-PLACE RADIX SORT (MSD, PARADIS-STYLE)
+// ============================================================================
+// Time Complexity: O(p * n / T) expected with T threads, p = key bytes
+// Space Complexity: O(T * 256) per level - no n-sized scratch array
+// Stability: No - elements are swapped across bucket boundaries
+// Best for: Large arrays on many cores when a second n-sized array does not fit
+// Each level partitions by one byte in rounds. In the speculative phase every
+// thread permutes elements within its own slice of every bucket, placing
+// what it can without synchronisation. In the repair phase each bucket moves
+// its correctly placed elements to the front; the misplaced remainder goes
+// into the next round. Buckets are then sorted by the next byte in parallel.
+
+// Run task(threadId) on threadCount threads, using the calling thread as id 0
+template<typename Task>
+void runOnThreads(int threadCount, Task task) {
+    vector<thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        workers.push_back(thread(task, t));
+    }
+    task(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template<typename Record, typename KeyFunction>
+void parallelRadixSortInPlace(Record* data, size_t n, int shift, KeyFunction keyOf, int threadCount) {
+    const int BASE = 256;
+    const size_t INSERTION_SORT_CUTOFF = 32;
+    const size_t MIN_ELEMENTS_PER_THREAD = 4096;
+    auto digitOf = [&](const Record& record) {
+        return static_cast<size_t>((keyOf(record) >> shift) & 0xFF);
+    };
+
+    if (n <= INSERTION_SORT_CUTOFF) {
+        for (size_t i = 1; i < n; i++) {
+            Record key = data[i];
+            size_t j = i;
+            while (j > 0 && keyOf(key) < keyOf(data[j - 1])) {
+                data[j] = data[j - 1];
+                j--;
+            }
+            data[j] = key;
+        }
+        return;
+    }
+    threadCount = max(1, min(threadCount, static_cast<int>(n / MIN_ELEMENTS_PER_THREAD)));
+
+    // Histogram of the current byte, one partial histogram per thread
+    vector<size_t> threadCounts(threadCount * BASE, 0);
+    runOnThreads(threadCount, [&](int t) {
+        size_t* count = &threadCounts[t * BASE];
+        for (size_t i = n * t / threadCount; i < n * (t + 1) / threadCount; i++) {
+            count[digitOf(data[i])]++;
+        }
+    });
+    vector<size_t> bucketStart(BASE + 1, 0);
+    for (int digit = 0; digit < BASE; digit++) {
+        size_t digitCount = 0;
+        for (int t = 0; t < threadCount; t++) {
+            digitCount += threadCounts[t * BASE + digit];
+        }
+        bucketStart[digit + 1] = bucketStart[digit] + digitCount;
+    }
+
+    // head[b]..tail[b] is the part of bucket b that may still hold misplaced elements
+    vector<size_t> head(bucketStart.begin(), bucketStart.end() - 1);
+    vector<size_t> tail(bucketStart.begin() + 1, bucketStart.end());
+    size_t previousRemaining = n + 1;
+    while (true) {
+        size_t remaining = 0;
+        for (int digit = 0; digit < BASE; digit++) {
+            remaining += tail[digit] - head[digit];
+        }
+        if (remaining == 0) break;
+
+        // A single-threaded round always places everything, so fall back to it
+        // when the remainder is small or the last round made no progress
+        int roundThreads = max(1, min(threadCount, static_cast<int>(remaining / MIN_ELEMENTS_PER_THREAD)));
+        if (remaining == previousRemaining) {
+            roundThreads = 1;
+        }
+        previousRemaining = remaining;
+
+        // Speculative phase: thread t owns slice t of every bucket's remainder
+        vector<size_t> placedEnd(roundThreads * BASE);
+        vector<size_t> sliceEnd(roundThreads * BASE);
+        for (int t = 0; t < roundThreads; t++) {
+            for (int digit = 0; digit < BASE; digit++) {
+                size_t size = tail[digit] - head[digit];
+                placedEnd[t * BASE + digit] = head[digit] + size * t / roundThreads;
+                sliceEnd[t * BASE + digit] = head[digit] + size * (t + 1) / roundThreads;
+            }
+        }
+        runOnThreads(roundThreads, [&](int t) {
+            size_t* placed = &placedEnd[t * BASE];
+            size_t* end = &sliceEnd[t * BASE];
+            for (int digit = 0; digit < BASE; digit++) {
+                // [slice start, placed) holds elements of this digit;
+                // [placed, scan) holds misplaced ones parked for the repair phase
+                for (size_t scan = placed[digit]; scan < end[digit]; scan++) {
+                    Record value = data[scan];
+                    size_t target = digitOf(value);
+                    while (target != static_cast<size_t>(digit) && placed[target] < end[target]) {
+                        swap(value, data[placed[target]++]);
+                        target = digitOf(value);
+                    }
+                    if (target == static_cast<size_t>(digit)) {
+                        data[scan] = data[placed[digit]];
+                        data[placed[digit]++] = value;
+                    }
+                    else {
+                        data[scan] = value;
+                    }
+                }
+            }
+        });
+
+        if (roundThreads == 1) break;
+
+        // Repair phase: pull each bucket's correct elements to its front
+        runOnThreads(roundThreads, [&](int t) {
+            for (int digit = t; digit < BASE; digit += roundThreads) {
+                Record* first = data + head[digit];
+                Record* last = data + tail[digit];
+                head[digit] += partition(first, last, [&](const Record& record) {
+                    return digitOf(record) == static_cast<size_t>(digit);
+                }) - first;
+            }
+        });
+    }
+
+    if (shift == 0) return;
+
+    // All keys share this byte: keep every thread on the next byte
+    for (int digit = 0; digit < BASE; digit++) {
+        if (bucketStart[digit + 1] - bucketStart[digit] == n) {
+            parallelRadixSortInPlace(data, n, shift - 8, keyOf, threadCount);
+            return;
+        }
+    }
+
+    // Recurse into buckets; threads claim the next unsorted bucket
+    atomic<int> nextBucket(0);
+    runOnThreads(threadCount, [&](int) {
+        for (int digit = nextBucket++; digit < BASE; digit = nextBucket++) {
+            parallelRadixSortInPlace(data + bucketStart[digit], bucketStart[digit + 1] - bucketStart[digit],
+                shift - 8, keyOf, 1);
+        }
+    });
+}
+
+template<typename Record, typename KeyFunction>
+void parallelRadixSortInPlace(vector<Record>& records, KeyFunction keyOf, int threadCount) {
+    if (records.size() < 2) return;
+    typedef decltype(keyOf(records.front())) Key;
+    parallelRadixSortInPlace(records.data(), records.size(), 8 * (static_cast<int>(sizeof(Key)) - 1),
+        keyOf, threadCount);
+}
+
+// ============================================================================
+// RADIX SORT (WIDE FIXED-WIDTH KEYS, MSD)
+// ============================================================================
+// Time Complexity: O(n * L) worst case for L-byte keys, typically O(n * log256 n)
+//                  because recursion stops once a bucket holds one element
+// Space Complexity: O(n + 256 * L)
+// Stability: Yes - every level is a stable counting scatter
+// Best for: UUIDs, hash digests, __int128 and other keys too wide for an
+//           LSD pass per byte
+// byteOf(record, depth) returns byte `depth` of the key, most significant
+// first, so the order is the same as memcmp on the key bytes. Bytes shared
+// by every key of a bucket are skipped in one scan instead of one histogram
+// pass each. Records carry any payload alongside the key.
+
+// Fixed-length byte key compared like memcmp
+template<size_t KEY_BYTES>
+struct FixedWidthKey {
+    uint8_t bytes[KEY_BYTES];
+
+    bool operator<(const FixedWidthKey& other) const { return memcmp(bytes, other.bytes, KEY_BYTES) < 0; }
+    bool operator==(const FixedWidthKey& other) const { return memcmp(bytes, other.bytes, KEY_BYTES) == 0; }
+};
+
+typedef FixedWidthKey<16> Uuid;
+typedef FixedWidthKey<20> Sha1Digest;
+
+template<typename Record, typename ByteFunction>
+void radixSortWideMSD(Record* data, Record* buffer, size_t n, size_t depth, size_t keyLength, ByteFunction& byteOf) {
+    const size_t INSERTION_SORT_CUTOFF = 32;
+
+    // Small buckets: stable insertion sort comparing from the current depth
+    if (n <= INSERTION_SORT_CUTOFF) {
+        auto lessFrom = [&](const Record& a, const Record& b) {
+            for (size_t d = depth; d < keyLength; d++) {
+                uint8_t byteA = byteOf(a, d);
+                uint8_t byteB = byteOf(b, d);
+                if (byteA != byteB) return byteA < byteB;
+            }
+            return false;
+        };
+        for (size_t i = 1; i < n; i++) {
+            Record current = data[i];
+            size_t j = i;
+            while (j > 0 && lessFrom(current, data[j - 1])) {
+                data[j] = data[j - 1];
+                j--;
+            }
+            data[j] = current;
+        }
+        return;
+    }
+
+    // Skip the prefix common to every key; exits after a few elements on random keys
+    size_t commonEnd = keyLength;
+    for (size_t i = 1; i < n && depth < commonEnd; i++) {
+        size_t d = depth;
+        while (d < commonEnd && byteOf(data[i], d) == byteOf(data[0], d)) d++;
+        commonEnd = d;
+    }
+    depth = commonEnd;
+    if (depth == keyLength) return;
+
+    size_t count[256] = {};
+    for (size_t i = 0; i < n; i++) {
+        count[byteOf(data[i], depth)]++;
+    }
+    size_t offsets[256];
+    size_t offset = 0;
+    for (int digit = 0; digit < 256; digit++) {
+        offsets[digit] = offset;
+        offset += count[digit];
+    }
+    for (size_t i = 0; i < n; i++) {
+        buffer[offsets[byteOf(data[i], depth)]++] = data[i];
+    }
+    copy(buffer, buffer + n, data);
+
+    if (depth + 1 == keyLength) return;
+    size_t start = 0;
+    for (int digit = 0; digit < 256; digit++) {
+        if (count[digit] > 1) {
+            radixSortWideMSD(data + start, buffer + start, count[digit], depth + 1, keyLength, byteOf);
+        }
+        start += count[digit];
+    }
+}
+
+template<typename Record, typename ByteFunction>
+void radixSortWideMSD(vector<Record>& records, ByteFunction byteOf, size_t keyLength) {
+    if (records.size() < 2 || keyLength == 0) return;
+
+    // Reserve the distribution buffer; downgrade to a bufferless stable sort
+    // comparing key bytes if the budget is short
+    ScratchReservation scratch(records.size() * sizeof(Record), false);
+    if (!scratch.granted()) {
+        MemoryBudget::instance().recordDowngrade();
+        stableSortInPlace(records.begin(), records.end(), [&](const Record& a, const Record& b) {
+            for (size_t d = 0; d < keyLength; d++) {
+                uint8_t byteA = byteOf(a, d);
+                uint8_t byteB = byteOf(b, d);
+                if (byteA != byteB) return byteA < byteB;
+            }
+            return false;
+        });
+        return;
     }
+    vector<Record> buffer(records.size());
+    radixSortWideMSD(records.data(), buffer.data(), records.size(), 0, keyLength, byteOf);
+}
+
+template<size_t KEY_BYTES>
+void sortFixedWidthKeys(vector<FixedWidthKey<KEY_BYTES>>& keys) {
+    radixSortWideMSD(keys, [](const FixedWidthKey<KEY_BYTES>& key, size_t depth) { return key.bytes[depth]; },
+        KEY_BYTES);
+}
+
+#ifdef __SIZEOF_INT128__
+// Byte `depth` of a signed 128-bit value, most significant first, sign bit flipped
+inline uint8_t int128ByteOf(__int128 value, size_t depth) {
+    unsigned __int128 key = static_cast<unsigned __int128>(value) ^ (static_cast<unsigned __int128>(1) << 127);
+    return static_cast<uint8_t>(key >> (8 * (15 - depth)));
+}
+
+void sortInt128(vector<__int128>& values) {
+    radixSortWideMSD(values, [](__int128 value, size_t depth) { return int128ByteOf(value, depth); }, 16);
 }
+#endif
 
 // ============================================================================
 // PIGEONHOLE SORT
@@ -149,6 +1065,13 @@ void pigeonholeSort(vector<int>& array) {
     int maxValue = *max_element(array.begin(), array.end());
     int range = maxValue - minValue + 1;
 
+    // Reserve the holes and their contents; downgrade (stable) if the budget is short
+    ScratchReservation scratch(static_cast<size_t>(range) * sizeof(vector<int>) + array.size() * sizeof(int), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array);
+        return;
+    }
+
     // Create pigeonholes - each hole stores all occurrences of a value
     vector<vector<int>> pigeonholes(range);
 
@@ -175,7 +1098,8 @@ void pigeonholeSort(vector<int>& array) {
 // Space Complexity: O(n + k) where k is number of buckets
 // Stability: Depends on sorting algorithm used within buckets
 // Best for: Uniformly distributed data over a range
-void bucketSort(vector<int>& array) {
+// Descending order walks the buckets from the top and flips the in-bucket comparison.
+void bucketSortOrdered(vector<int>& array, SortOrder order) {
     if (array.empty()) return;
 
     // Find range for bucket distribution
@@ -185,10 +1109,18 @@ void bucketSort(vector<int>& array) {
     // Handle case where all elements are the same
     if (minValue == maxValue) return;
 
-    // Determine number of buckets (heuristic: use array size)
-    int bucketCount = max(1, static_cast<int>(array.size()));
+    // Determine number of buckets (heuristic: array size / tuned load factor)
+    const TuningProfile& profile = tuningProfile();
+    int bucketCount = max(1, static_cast<int>(array.size()) / profile.bucketLoadFactor);
     int range = maxValue - minValue + 1;
 
+    // Reserve the buckets and their contents; downgrade if the budget is short
+    ScratchReservation scratch(static_cast<size_t>(bucketCount) * sizeof(vector<int>) + array.size() * sizeof(int), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array, order);
+        return;
+    }
+
     // Create empty buckets
     vector<vector<int>> buckets(bucketCount);
 
@@ -200,13 +1132,20 @@ void bucketSort(vector<int>& array) {
         buckets[bucketIndex].push_back(value);
     }
 
-    // Sort individual buckets using insertion sort (stable and efficient for small arrays)
+    // Sort individual buckets using insertion sort (stable and efficient for small arrays);
+    // buckets above the tuned cutoff use std::sort instead
+    bool descending = order == DESCENDING;
     for (auto& bucket : buckets) {
+        if (bucket.size() > profile.bucketInsertionCutoff) {
+            if (descending) sort(bucket.begin(), bucket.end(), greater<int>());
+            else sort(bucket.begin(), bucket.end());
+            continue;
+        }
         // Insertion sort on each bucket
         for (size_t i = 1; i < bucket.size(); i++) {
             int key = bucket[i];
             int j = i - 1;
-            while (j >= 0 && bucket[j] > key) {
+            while (j >= 0 && (descending ? bucket[j] < key : bucket[j] > key)) {
                 bucket[j + 1] = bucket[j];
                 j--;
             }
@@ -216,346 +1155,4235 @@ void bucketSort(vector<int>& array) {
 
     // Concatenate all sorted buckets back into original array
     int arrayIndex = 0;
-    for (const auto& bucket : buckets) {
-        for (int value : bucket) {
+    for (int b = 0; b < bucketCount; b++) {
+        for (int value : buckets[descending ? bucketCount - 1 - b : b]) {
             array[arrayIndex] = value;
             arrayIndex++;
         }
     }
 }
 
+void bucketSort(vector<int>& array) {
+    bucketSortOrdered(array, ASCENDING);
+}
+
+void bucketSortDescending(vector<int>& array) {
+    bucketSortOrdered(array, DESCENDING);
+}
+
 // ============================================================================
-// UTILITY FUNCTIONS FOR TESTING
+// BUCKET SORT (LEARNED CDF MAPPING)
 // ============================================================================
+// Time Complexity: O(n + s log s) on smooth distributions, s = sample size
+// Space Complexity: O(n + k) where k is number of buckets
+// Stability: Yes - stable scatter followed by stable in-bucket sorting
+// Best for: Non-uniform but smooth distributions (normal, skewed, exponential)
+//           where the linear min/max mapping of bucketSort overfills buckets
+void bucketSortLearnedCDF(vector<int>& array) {
+    const size_t INSERTION_SORT_CUTOFF = tuningProfile().learnedInsertionCutoff;
+    const size_t SAMPLE_SIZE = 1024;
+    const int SEGMENTS = 64;
 
-// Print array contents (with limit for large arrays)
-void printArray(const vector<int>& array, const string& label, int maxElements = 20) {
-    cout << label << ": ";
-    int elementsToShow = min(static_cast<int>(array.size()), maxElements);
-    for (int i = 0; i < elementsToShow; i++) {
-        cout << array[i] << " ";
+    size_t n = array.size();
+    if (n < 2) return;
+
+    // Reserve the bucket ids, bucket offsets and output array; downgrade
+    // (stable) if the budget is short
+    size_t bucketCount = max<size_t>(1, n / tuningProfile().learnedBucketLoadFactor);
+    ScratchReservation scratch(n * (sizeof(size_t) + sizeof(int)) + 2 * (bucketCount + 1) * sizeof(size_t), false);
+    if (!scratch.granted()) {
+        downgradeToInPlaceRadix(array);
+        return;
     }
-    if (array.size() > static_cast<size_t>(maxElements)) {
-        cout << "... (" << array.size() << " total elements)";
+
+    // Draw an evenly strided sample and sort it to obtain empirical quantiles
+    size_t sampleSize = min(n, SAMPLE_SIZE);
+    vector<int> sample(sampleSize);
+    for (size_t i = 0; i < sampleSize; i++) {
+        sample[i] = array[i * n / sampleSize];
     }
-    cout << endl;
+    sort(sample.begin(), sample.end());
+
+    // Piecewise-linear CDF model: knot j sits at the (j / SEGMENTS) quantile
+    vector<int> knots(SEGMENTS + 1);
+    for (int j = 0; j <= SEGMENTS; j++) {
+        knots[j] = sample[(sampleSize - 1) * j / SEGMENTS];
+    }
+
+    // Predict a bucket from the model; monotone in value, so buckets are ordered
+    auto predictBucket = [&](int value) -> size_t {
+        if (value <= knots.front()) return 0;
+        if (value >= knots.back()) return bucketCount - 1;
+        int segment = static_cast<int>(upper_bound(knots.begin(), knots.end(), value) - knots.begin()) - 1;
+        double width = static_cast<double>(knots[segment + 1]) - knots[segment];
+        double fraction = width > 0 ? (static_cast<double>(value) - knots[segment]) / width : 0.0;
+        double cdf = (segment + fraction) / SEGMENTS;
+        return min(bucketCount - 1, static_cast<size_t>(cdf * bucketCount));
+    };
+
+    // Counting-sort style scatter places every element near its final position
+    vector<size_t> bucketOf(n);
+    vector<size_t> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        bucketOf[i] = predictBucket(array[i]);
+        bucketStart[bucketOf[i] + 1]++;
+    }
+    for (size_t b = 1; b <= bucketCount; b++) {
+        bucketStart[b] += bucketStart[b - 1];
+    }
+    vector<int> outputArray(n);
+    vector<size_t> nextSlot(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        outputArray[nextSlot[bucketOf[i]]++] = array[i];
+    }
+
+    // Touch-up pass: insertion sort within each bucket; buckets the model
+    // overfilled (e.g. heavy duplicates) fall back to a stable O(m log m) sort
+    for (size_t b = 0; b < bucketCount; b++) {
+        auto first = outputArray.begin() + bucketStart[b];
+        auto last = outputArray.begin() + bucketStart[b + 1];
+        if (last - first < 2) continue;
+        if (static_cast<size_t>(last - first) > INSERTION_SORT_CUTOFF) {
+            stable_sort(first, last);
+            continue;
+        }
+        for (auto it = first + 1; it < last; ++it) {
+            int key = *it;
+            auto hole = it;
+            while (hole != first && *(hole - 1) > key) {
+                *hole = *(hole - 1);
+                --hole;
+            }
+            *hole = key;
+        }
+    }
+
+    array = move(outputArray);
 }
 
-// Verify that an array is sorted correctly
-bool isSorted(const vector<int>& array) {
-    for (size_t i = 1; i < array.size(); i++) {
-        if (array[i] < array[i - 1]) {
-            return false;
+// ============================================================================
+// RANGE PARTITIONING (BUCKETIZE)
+// ============================================================================
+// Time Complexity: O(n log P) with splitters, O(n) with equal-width bins
+// Space Complexity: O(n + T * P) for T threads and P partitions
+// Stability: Yes - each partition keeps the input order of its keys
+// Best for: Sharding and histogram binning where only the partition, not the
+//           full order, matters (the first step of bucket sort and MSD radix)
+// Splitters s[0] <= ... <= s[P-2] define partition p = [s[p-1], s[p]); the
+// first and last partitions are open-ended. Classification runs level by level
+// over blocks of keys, a branch-free loop the compiler can vectorise. Every
+// thread then counts its slice, and one scatter pass writes the output.
+
+struct PartitionResult {
+    vector<int> values;      // partition p is values[offsets[p] .. offsets[p + 1])
+    vector<size_t> offsets;  // partitionCount + 1 entries
+};
+
+// Count per (thread, partition), then scatter each slice to its global offsets
+inline PartitionResult scatterByPartition(const vector<int>& values, const vector<uint32_t>& partitionOf,
+    size_t partitionCount, int threadCount) {
+    size_t n = values.size();
+    size_t slice = (n + threadCount - 1) / threadCount;
+    vector<size_t> counts(threadCount * partitionCount, 0);
+    runOnThreads(threadCount, [&](int t) {
+        size_t* count = &counts[t * partitionCount];
+        for (size_t i = t * slice; i < min(n, (t + 1) * slice); i++) count[partitionOf[i]]++;
+    });
+
+    PartitionResult result;
+    result.offsets.assign(partitionCount + 1, 0);
+    size_t offset = 0;
+    for (size_t p = 0; p < partitionCount; p++) {
+        result.offsets[p] = offset;
+        for (int t = 0; t < threadCount; t++) {
+            size_t partitionSize = counts[t * partitionCount + p];
+            counts[t * partitionCount + p] = offset;
+            offset += partitionSize;
+        }
+    }
+    result.offsets[partitionCount] = offset;
+
+    result.values.resize(n);
+    runOnThreads(threadCount, [&](int t) {
+        size_t* position = &counts[t * partitionCount];
+        for (size_t i = t * slice; i < min(n, (t + 1) * slice); i++) {
+            result.values[position[partitionOf[i]]++] = values[i];
+        }
+    });
+    return result;
+}
+
+// Partition ids, per-thread counts and output of one partitioning call
+inline size_t partitioningBytes(size_t n, size_t partitionCount, int threadCount) {
+    return n * (sizeof(uint32_t) + sizeof(int)) + static_cast<size_t>(threadCount) * partitionCount * sizeof(size_t);
+}
+
+PartitionResult partitionBySplitters(const vector<int>& values, const vector<int>& splitters, int threadCount = 1) {
+    const size_t BLOCK = 256;
+    size_t partitionCount = splitters.size() + 1;
+    threadCount = max(1, min(threadCount, static_cast<int>(values.size() / 4096) + 1));
+
+    // Partitioning has no in-place variant, so it queues for its memory
+    ScratchReservation scratch(partitioningBytes(values.size(), partitionCount, threadCount), true);
+
+    // Pad the splitters to 2^k - 1 with INT_MAX so every search takes k steps
+    size_t paddedSize = 1;
+    while (paddedSize < partitionCount) paddedSize *= 2;
+    vector<int> padded(splitters);
+    padded.resize(paddedSize - 1, numeric_limits<int>::max());
+
+    size_t n = values.size();
+    size_t slice = (n + threadCount - 1) / threadCount;
+    vector<uint32_t> partitionOf(n);
+    runOnThreads(threadCount, [&](int t) {
+        uint32_t position[BLOCK];
+        size_t end = min(n, (t + 1) * slice);
+        for (size_t blockStart = t * slice; blockStart < end; blockStart += BLOCK) {
+            size_t blockSize = min(end - blockStart, BLOCK);
+            const int* keys = &values[blockStart];
+            fill(position, position + blockSize, 0);
+            // Branch-free upper_bound, one level for the whole block at a time;
+            // the multiply (not ?:) keeps compilers from emitting a branch
+            for (size_t step = paddedSize / 2; step > 0; step /= 2) {
+                const int* level = &padded[step - 1];
+                for (size_t i = 0; i < blockSize; i++) {
+                    position[i] += static_cast<uint32_t>(keys[i] >= level[position[i]]) * static_cast<uint32_t>(step);
+                }
+            }
+            copy(position, position + blockSize, &partitionOf[blockStart]);
+        }
+    });
+    // Keys >= INT_MAX padding land past the real partitions; fold them into the last
+    if (paddedSize > partitionCount) {
+        for (uint32_t& p : partitionOf) p = min<uint32_t>(p, static_cast<uint32_t>(partitionCount - 1));
+    }
+    return scatterByPartition(values, partitionOf, partitionCount, threadCount);
+}
+
+// P bins of equal width over [min, max]
+PartitionResult partitionEqualWidth(const vector<int>& values, size_t partitionCount, int threadCount = 1) {
+    partitionCount = max<size_t>(1, partitionCount);
+    threadCount = max(1, min(threadCount, static_cast<int>(values.size() / 4096) + 1));
+    if (values.empty()) {
+        PartitionResult result;
+        result.offsets.assign(partitionCount + 1, 0);
+        return result;
+    }
+    long long minValue = *min_element(values.begin(), values.end());
+    long long range = *max_element(values.begin(), values.end()) - minValue + 1;
+    ScratchReservation scratch(partitioningBytes(values.size(), partitionCount, threadCount), true);
+
+    size_t n = values.size();
+    size_t slice = (n + threadCount - 1) / threadCount;
+    vector<uint32_t> partitionOf(n);
+    runOnThreads(threadCount, [&](int t) {
+        for (size_t i = t * slice; i < min(n, (t + 1) * slice); i++) {
+            partitionOf[i] = static_cast<uint32_t>((values[i] - minValue) * static_cast<long long>(partitionCount) / range);
         }
+    });
+    return scatterByPartition(values, partitionOf, partitionCount, threadCount);
+}
+
+// ============================================================================
+// DISTRIBUTED SAMPLE SORT (LOCAL PROCESSES)
+// ============================================================================
+// Time Complexity: O(n / P) local work per process plus O(n / P) bytes
+//                  shuffled per process, for P processes
+// Space Complexity: O(n / P) per process
+// Stability: No (keys only)
+// Best for: Prototyping scale-out sorting on one host before moving to a cluster
+// The coordinator forks P worker processes connected by a full mesh of Unix
+// domain sockets. Each worker starts with its own slice of the input, as if
+// the data already lived on that node, and then:
+//   1. samples its slice and all-gathers the samples, so every worker derives
+//      the same P - 1 splitters
+//   2. partitions its slice with partitionBySplitters
+//   3. shuffles partition j to worker j (all-to-all)
+//   4. sorts what it received with the byte radix engine
+// The sorted ranges go back to the coordinator in rank order. All messages are
+// length-prefixed byte streams on socket descriptors, so the same code runs
+// over TCP connections between machines.
+
+struct DistributedSortReport {
+    double sampleMs = 0;     // slowest worker, per phase
+    double partitionMs = 0;
+    double shuffleMs = 0;
+    double localSortMs = 0;
+    double totalMs = 0;      // coordinator wall time including fork and collection
+    size_t bytesShuffled = 0;
+    bool succeeded = false;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+#ifdef MSG_NOSIGNAL
+const int SOCKET_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SOCKET_SEND_FLAGS = 0;
+#endif
+
+bool sendAllBytes(int fd, const void* data, size_t bytes) {
+    const char* cursor = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t sent = send(fd, cursor, bytes, SOCKET_SEND_FLAGS);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        cursor += sent;
+        bytes -= static_cast<size_t>(sent);
     }
     return true;
 }
 
-// Measure execution time of a sorting algorithm
-template<typename SortFunction>
-double measureSortingTime(vector<int> array, SortFunction sortFunc, const string& algorithmName) {
-    auto startTime = high_resolution_clock::now();
-    sortFunc(array);
-    auto endTime = high_resolution_clock::now();
+bool receiveAllBytes(int fd, void* data, size_t bytes) {
+    char* cursor = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t received = recv(fd, cursor, bytes, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        cursor += received;
+        bytes -= static_cast<size_t>(received);
+    }
+    return true;
+}
 
-    duration<double, milli> executionTime = endTime - startTime;
+// One message: element count as uint64, then the raw elements
+template<typename Value>
+bool sendMessage(int fd, const vector<Value>& values) {
+    uint64_t count = values.size();
+    return sendAllBytes(fd, &count, sizeof(count)) && sendAllBytes(fd, values.data(), values.size() * sizeof(Value));
+}
 
-    // Verify the sort was successful
-    if (!isSorted(array)) {
-        cout << "ERROR: " << algorithmName << " did not sort correctly!" << endl;
+template<typename Value>
+bool receiveMessage(int fd, vector<Value>& values) {
+    uint64_t count = 0;
+    if (!receiveAllBytes(fd, &count, sizeof(count))) return false;
+    values.resize(count);
+    return receiveAllBytes(fd, values.data(), count * sizeof(Value));
+}
+
+// Send outgoing[j] to every peer j while one thread per peer drains its
+// socket, so no send can block forever on a full buffer
+bool exchangeAllToAll(const vector<int>& peerSockets, int rank, vector<vector<int>>& outgoing,
+    vector<vector<int>>& incoming) {
+    int processCount = static_cast<int>(peerSockets.size());
+    incoming.assign(processCount, vector<int>());
+    incoming[rank].swap(outgoing[rank]);
+    atomic<bool> succeeded(true);
+    vector<thread> receivers;
+    for (int peer = 0; peer < processCount; peer++) {
+        if (peer == rank) continue;
+        receivers.push_back(thread([&, peer]() {
+            if (!receiveMessage(peerSockets[peer], incoming[peer])) succeeded = false;
+        }));
+    }
+    for (int step = 1; step < processCount; step++) {
+        int peer = (rank + step) % processCount;
+        if (!sendMessage(peerSockets[peer], outgoing[peer])) succeeded = false;
+    }
+    for (auto& receiver : receivers) {
+        receiver.join();
     }
+    return succeeded;
+}
 
-    return executionTime.count();
+// Worker body; everything it reports goes through coordinatorSocket
+void runSampleSortWorker(int rank, const int* slice, size_t sliceSize, const vector<int>& peerSockets,
+    int coordinatorSocket, size_t samplesPerProcess) {
+    int processCount = static_cast<int>(peerSockets.size());
+    auto phaseStart = high_resolution_clock::now();
+    auto lapMs = [&phaseStart]() {
+        auto now = high_resolution_clock::now();
+        duration<double, milli> elapsed = now - phaseStart;
+        phaseStart = now;
+        return elapsed.count();
+    };
+
+    // 1. Sample locally, all-gather, pick splitters at evenly spaced ranks
+    mt19937 generator(static_cast<unsigned>(rank) + 1);
+    vector<vector<int>> outgoing(processCount), incoming;
+    vector<int> localSamples;
+    for (size_t s = 0; s < samplesPerProcess && sliceSize > 0; s++) {
+        localSamples.push_back(slice[generator() % sliceSize]);
+    }
+    for (int peer = 0; peer < processCount; peer++) {
+        outgoing[peer] = localSamples;
+    }
+    bool succeeded = exchangeAllToAll(peerSockets, rank, outgoing, incoming);
+    vector<int> samples;
+    for (const auto& peerSamples : incoming) {
+        samples.insert(samples.end(), peerSamples.begin(), peerSamples.end());
+    }
+    sort(samples.begin(), samples.end());
+    vector<int> splitters;
+    for (int p = 1; p < processCount && !samples.empty(); p++) {
+        splitters.push_back(samples[p * samples.size() / processCount]);
+    }
+    double sampleMs = lapMs();
+
+    // 2. Partition the local slice into one range per worker
+    PartitionResult partitions = partitionBySplitters(vector<int>(slice, slice + sliceSize), splitters);
+    for (int peer = 0; peer < processCount; peer++) {
+        outgoing[peer].assign(partitions.values.begin() + partitions.offsets[peer],
+            partitions.values.begin() + partitions.offsets[peer + 1]);
+    }
+    double partitionMs = lapMs();
+
+    // 3. All-to-all shuffle
+    double bytesShuffled = static_cast<double>(sliceSize - outgoing[rank].size()) * sizeof(int);
+    succeeded = exchangeAllToAll(peerSockets, rank, outgoing, incoming) && succeeded;
+    double shuffleMs = lapMs();
+
+    // 4. Local sort of this worker's key range
+    vector<int> local;
+    for (const auto& received : incoming) {
+        local.insert(local.end(), received.begin(), received.end());
+    }
+    radixSortByteLSD(local, [](int value) { return radixKeyOf(value); });
+    double localSortMs = lapMs();
+
+    vector<double> timings = { sampleMs, partitionMs, shuffleMs, localSortMs, bytesShuffled, succeeded ? 1.0 : 0.0 };
+    sendMessage(coordinatorSocket, local);
+    sendMessage(coordinatorSocket, timings);
 }
 
-// Generate test array
-vector<int> generateTestArray() {
-    return { 170, 45, 75, 90, 802, 24, 2, 66 };
+// Sorts values in place; on failure values is left unchanged
+DistributedSortReport distributedSampleSort(vector<int>& values, int processCount, size_t samplesPerProcess = 256) {
+    DistributedSortReport report;
+    auto totalStart = high_resolution_clock::now();
+    processCount = max(1, processCount);
+
+    // mesh[i][j] is worker i's end of the (i, j) socket pair
+    vector<vector<int>> mesh(processCount, vector<int>(processCount, -1));
+    vector<int> coordinatorSockets(processCount, -1), workerSockets(processCount, -1);
+    // The first failure stops both loops; closeAll then releases what was made
+    bool socketsReady = true;
+    for (int i = 0; i < processCount && socketsReady; i++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) { socketsReady = false; break; }
+        coordinatorSockets[i] = pair[0];
+        workerSockets[i] = pair[1];
+        for (int j = i + 1; j < processCount && socketsReady; j++) {
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) { socketsReady = false; break; }
+            mesh[i][j] = pair[0];
+            mesh[j][i] = pair[1];
+        }
+    }
+    auto closeAll = [&]() {
+        for (auto& row : mesh) for (int fd : row) if (fd >= 0) close(fd);
+        for (int fd : workerSockets) if (fd >= 0) close(fd);
+        for (int fd : coordinatorSockets) if (fd >= 0) close(fd);
+    };
+    if (!socketsReady) {
+        closeAll();
+        return report;
+    }
+
+    // Children inherit the input copy-on-write; each reads only its slice
+    cout.flush();
+    vector<pid_t> workers;
+    for (int rank = 0; rank < processCount; rank++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            for (int i = 0; i < processCount; i++) {
+                close(coordinatorSockets[i]);
+                if (i != rank) {
+                    close(workerSockets[i]);
+                    for (int fd : mesh[i]) if (fd >= 0) close(fd);
+                }
+            }
+            size_t begin = values.size() * rank / processCount;
+            size_t end = values.size() * (rank + 1) / processCount;
+            runSampleSortWorker(rank, values.data() + begin, end - begin, mesh[rank], workerSockets[rank],
+                samplesPerProcess);
+            _exit(0);
+        }
+        if (pid > 0) workers.push_back(pid);
+    }
+    for (auto& row : mesh) for (int& fd : row) if (fd >= 0) { close(fd); fd = -1; }
+    for (int& fd : workerSockets) { close(fd); fd = -1; }
+
+    // Collect the sorted ranges in rank order
+    bool succeeded = static_cast<int>(workers.size()) == processCount;
+    vector<int> result;
+    result.reserve(values.size());
+    for (int rank = 0; rank < processCount && succeeded; rank++) {
+        vector<int> range;
+        vector<double> timings;
+        if (!receiveMessage(coordinatorSockets[rank], range) || !receiveMessage(coordinatorSockets[rank], timings) ||
+            timings.size() != 6 || timings[5] != 1.0) {
+            succeeded = false;
+            break;
+        }
+        result.insert(result.end(), range.begin(), range.end());
+        report.sampleMs = max(report.sampleMs, timings[0]);
+        report.partitionMs = max(report.partitionMs, timings[1]);
+        report.shuffleMs = max(report.shuffleMs, timings[2]);
+        report.localSortMs = max(report.localSortMs, timings[3]);
+        report.bytesShuffled += static_cast<size_t>(timings[4]);
+    }
+    closeAll();
+    for (pid_t pid : workers) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) succeeded = false;
+    }
+
+    if (succeeded && result.size() == values.size()) {
+        values.swap(result);
+        report.succeeded = true;
+    }
+    duration<double, milli> totalTime = high_resolution_clock::now() - totalStart;
+    report.totalMs = totalTime.count();
+    return report;
 }
+#else
+// No fork or Unix sockets: sort in-process and report only the local sort
+DistributedSortReport distributedSampleSort(vector<int>& values, int, size_t = 256) {
+    DistributedSortReport report;
+    auto sortStart = high_resolution_clock::now();
+    radixSortByteLSD(values, [](int value) { return radixKeyOf(value); });
+    duration<double, milli> sortTime = high_resolution_clock::now() - sortStart;
+    report.localSortMs = report.totalMs = sortTime.count();
+    report.succeeded = true;
+    return report;
+}
+#endif
 
 // ============================================================================
-// TEST CASE GENERATORS
+// SHARED-MEMORY SORT SERVICE
 // ============================================================================
+// A local sort daemon. Processes that need sorting use it instead of each
+// embedding its own engine and thread pool. A client puts its keys in a
+// SharedSortBuffer (an anonymous shared-memory segment) and passes the
+// segment's descriptor over a Unix socket (SCM_RIGHTS). The daemon maps the
+// same pages, sorts them in place and replies, so the keys never cross the
+// socket. All requests share one parallel in-place radix engine: a job
+// takes every engine thread, and jobs run one at a time, so the host never
+// runs more sorting threads than it has cores however many clients submit.
+// The engine threads are started per job rather than kept in a pool; the
+// service bounds how many run at once, not how often they are created.
+// Each client connection has its own thread, joined as soon as it finishes.
+// On shutdown the daemon shuts down every client socket, so an idle client
+// cannot keep it alive. The service does no NUMA handling: engine threads
+// are not pinned and pages are not placed, they stay wherever the client
+// first touched them.
 
-// Test Case 1: Generate arrays with varying range sizes
-vector<int> generateVaryingRangeArray(int size, int maxRange) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
-    uniform_int_distribution<> distribution(0, maxRange);
+#if defined(__unix__) || defined(__APPLE__)
+enum SortServiceOperation : uint32_t { SORT_SERVICE_SORT = 1, SORT_SERVICE_SHUTDOWN = 2 };
 
-    for (int i = 0; i < size; i++) {
-        result[i] = distribution(generator);
+struct SortServiceRequest {
+    uint32_t operation;
+    uint32_t order;        // SortOrder
+    uint64_t count;        // keys in the attached segment
+};
+
+// Send bytes with one descriptor attached as ancillary data
+bool sendWithDescriptor(int socketFd, const void* data, size_t bytes, int descriptor) {
+    struct msghdr message = {};
+    struct iovec payload = { const_cast<void*>(data), bytes };
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    if (descriptor >= 0) {
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(header), &descriptor, sizeof(int));
     }
-    return result;
+    ssize_t sent = sendmsg(socketFd, &message, SOCKET_SEND_FLAGS);
+    if (sent <= 0) return false;
+    return sendAllBytes(socketFd, static_cast<const char*>(data) + sent, bytes - static_cast<size_t>(sent));
 }
 
-// Test Case 2: Generate arrays with different distributions
-enum Distribution { UNIFORM, NORMAL, SKEWED, EXPONENTIAL };
+// Receive exactly `bytes`; *descriptor is the attached descriptor or -1
+bool receiveWithDescriptor(int socketFd, void* data, size_t bytes, int* descriptor) {
+    *descriptor = -1;
+    struct msghdr message = {};
+    struct iovec payload = { data, bytes };
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t received = recvmsg(socketFd, &message, 0);
+    if (received <= 0) return false;
+    for (struct cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+            memcpy(descriptor, CMSG_DATA(header), sizeof(int));
+        }
+    }
+    return receiveAllBytes(socketFd, static_cast<char*>(data) + received, bytes - static_cast<size_t>(received));
+}
 
-vector<int> generateDistributionArray(int size, Distribution distributionType) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
+// Client-side array of ints in an anonymous shared-memory segment
+class SharedSortBuffer {
+public:
+    explicit SharedSortBuffer(size_t count) : keyCount(count) {
+        static atomic<unsigned> segmentCounter(0);
+        string name = "/sorting_demo_" + to_string(getpid()) + "_" + to_string(segmentCounter++);
+        descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (descriptor < 0) return;
+        shm_unlink(name.c_str());
+        size_t bytes = max<size_t>(1, count) * sizeof(int);
+        if (ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) return;
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        if (mapping != MAP_FAILED) keys = static_cast<int*>(mapping);
+    }
 
-    switch (distributionType) {
-    case UNIFORM: {
-        uniform_int_distribution<> distribution(0, 1000);
-        for (int i = 0; i < size; i++) {
-            result[i] = distribution(generator);
+    ~SharedSortBuffer() {
+        if (keys != nullptr) munmap(keys, max<size_t>(1, keyCount) * sizeof(int));
+        if (descriptor >= 0) close(descriptor);
+    }
+
+    SharedSortBuffer(const SharedSortBuffer&) = delete;
+    SharedSortBuffer& operator=(const SharedSortBuffer&) = delete;
+
+    bool valid() const { return keys != nullptr; }
+    int* data() { return keys; }
+    size_t size() const { return keyCount; }
+    int segmentDescriptor() const { return descriptor; }
+
+private:
+    int descriptor = -1;
+    int* keys = nullptr;
+    size_t keyCount;
+};
+
+inline bool fillUnixAddress(const string& socketPath, struct sockaddr_un& address) {
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) return false;
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    return true;
+}
+
+class SortServiceClient {
+public:
+    explicit SortServiceClient(const string& socketPath) {
+        struct sockaddr_un address;
+        if (!fillUnixAddress(socketPath, address)) return;
+        socketFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socketFd >= 0 && connect(socketFd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+            close(socketFd);
+            socketFd = -1;
         }
-        break;
     }
-    case NORMAL: {
-        normal_distribution<> distribution(500, 150);
-        for (int i = 0; i < size; i++) {
-            result[i] = max(0, min(1000, static_cast<int>(distribution(generator))));
+
+    ~SortServiceClient() {
+        if (socketFd >= 0) close(socketFd);
+    }
+
+    SortServiceClient(const SortServiceClient&) = delete;
+    SortServiceClient& operator=(const SortServiceClient&) = delete;
+
+    bool connected() const { return socketFd >= 0; }
+
+    // Blocks until the daemon has sorted the buffer in place
+    bool sort(SharedSortBuffer& buffer, SortOrder order = ASCENDING) {
+        if (!connected() || !buffer.valid()) return false;
+        SortServiceRequest request = { SORT_SERVICE_SORT, static_cast<uint32_t>(order), buffer.size() };
+        uint32_t status = 1;
+        return sendWithDescriptor(socketFd, &request, sizeof(request), buffer.segmentDescriptor()) &&
+            receiveAllBytes(socketFd, &status, sizeof(status)) && status == 0;
+    }
+
+    bool requestShutdown() {
+        SortServiceRequest request = { SORT_SERVICE_SHUTDOWN, 0, 0 };
+        return connected() && sendAllBytes(socketFd, &request, sizeof(request));
+    }
+
+private:
+    int socketFd = -1;
+};
+
+class SortService {
+public:
+    SortService(const string& path, int engineThreads) : socketPath(path), threadCount(max(1, engineThreads)) {}
+
+    // Accepts clients until one of them requests shutdown; false if the socket cannot be bound
+    bool run() {
+        struct sockaddr_un address;
+        if (!fillUnixAddress(socketPath, address)) return false;
+        int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) return false;
+        unlink(socketPath.c_str());
+        if (::bind(listenFd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenFd, 64) != 0) {
+            close(listenFd);
+            return false;
         }
-        break;
+
+        vector<ClientConnection> connections;
+        while (!stopping) {
+            reapFinishedConnections(connections);
+            // Poll with a timeout so a shutdown request is noticed promptly
+            struct pollfd listener = { listenFd, POLLIN, 0 };
+            if (poll(&listener, 1, 50) <= 0) continue;
+            int clientFd = accept(listenFd, nullptr, nullptr);
+            if (clientFd < 0) continue;
+            ClientConnection connection;
+            connection.socketFd = clientFd;
+            connection.finished = make_shared<atomic<bool>>(false);
+            connection.worker = thread(&SortService::serveClient, this, clientFd, connection.finished);
+            connections.push_back(move(connection));
+        }
+        close(listenFd);
+        unlink(socketPath.c_str());
+        // Wake clients blocked in receive; their threads then see end-of-stream
+        for (auto& connection : connections) {
+            shutdown(connection.socketFd, SHUT_RDWR);
+        }
+        for (auto& connection : connections) {
+            connection.worker.join();
+            close(connection.socketFd);
+        }
+        return true;
     }
-    case SKEWED: {
-        // Right-skewed distribution (more small values)
-        exponential_distribution<> distribution(0.003);
-        for (int i = 0; i < size; i++) {
-            result[i] = min(1000, static_cast<int>(distribution(generator)));
+
+    size_t jobsCompleted() const { return completedJobs; }
+
+private:
+    // The accept loop owns socketFd and closes it after joining the worker,
+    // so shutdown() never reaches a descriptor number the process reused
+    struct ClientConnection {
+        thread worker;
+        int socketFd;
+        shared_ptr<atomic<bool>> finished;
+    };
+
+    // Join the threads of clients that have disconnected, so a long-running
+    // daemon holds threads only for live connections
+    static void reapFinishedConnections(vector<ClientConnection>& connections) {
+        size_t kept = 0;
+        for (size_t c = 0; c < connections.size(); c++) {
+            if (connections[c].finished->load()) {
+                connections[c].worker.join();
+                close(connections[c].socketFd);
+                continue;
+            }
+            if (kept != c) connections[kept] = move(connections[c]);
+            kept++;
         }
-        break;
+        connections.resize(kept);
     }
-    case EXPONENTIAL: {
-        exponential_distribution<> distribution(0.005);
-        for (int i = 0; i < size; i++) {
-            result[i] = min(1000, static_cast<int>(distribution(generator)));
+
+    void serveClient(int clientFd, shared_ptr<atomic<bool>> finished) {
+        SortServiceRequest request;
+        int segment = -1;
+        while (receiveWithDescriptor(clientFd, &request, sizeof(request), &segment)) {
+            if (request.operation == SORT_SERVICE_SHUTDOWN) {
+                stopping = true;
+                break;
+            }
+            uint32_t status = sortSegment(segment, request) ? 0 : 1;
+            if (segment >= 0) close(segment);
+            segment = -1;
+            if (!sendAllBytes(clientFd, &status, sizeof(status))) break;
         }
-        break;
+        if (segment >= 0) close(segment);
+        finished->store(true);
     }
+
+    bool sortSegment(int segment, const SortServiceRequest& request) {
+        if (segment < 0 || request.operation != SORT_SERVICE_SORT) return false;
+        if (request.count == 0) return true;
+        // The count comes from the client; reject one whose byte size overflows
+        if (request.count > numeric_limits<size_t>::max() / sizeof(int)) return false;
+        size_t bytes = static_cast<size_t>(request.count) * sizeof(int);
+        struct stat segmentStat;
+        if (fstat(segment, &segmentStat) != 0 || static_cast<size_t>(segmentStat.st_size) < bytes) return false;
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, segment, 0);
+        if (mapping == MAP_FAILED) return false;
+        int* keys = static_cast<int*>(mapping);
+        {
+            // One job at a time owns every engine thread
+            lock_guard<mutex> lock(engineMutex);
+            if (request.order == DESCENDING) {
+                parallelRadixSortInPlace(keys, request.count, 24, [](int value) { return radixKeyOfDescending(value); },
+                    threadCount);
+            }
+            else {
+                parallelRadixSortInPlace(keys, request.count, 24, [](int value) { return radixKeyOf(value); }, threadCount);
+            }
+            completedJobs++;
+        }
+        munmap(mapping, bytes);
+        return true;
     }
-    return result;
+
+    string socketPath;
+    int threadCount;
+    atomic<bool> stopping{ false };
+    atomic<size_t> completedJobs{ 0 };
+    mutex engineMutex;
+};
+#endif
+
+// ============================================================================
+// MERGING SORTED RUNS
+// ============================================================================
+// Time Complexity: O(n log r) where r is the number of runs
+// Space Complexity: O(n)
+// Stability: Yes - runs are merged pairwise, earlier runs win ties
+vector<int> mergeSortedRuns(vector<vector<int>> runs) {
+    if (runs.empty()) return vector<int>();
+
+    // Merge neighbouring pairs until a single run remains
+    while (runs.size() > 1) {
+        vector<vector<int>> mergedRuns;
+        for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+            vector<int> merged(runs[i].size() + runs[i + 1].size());
+            merge(runs[i].begin(), runs[i].end(), runs[i + 1].begin(), runs[i + 1].end(), merged.begin());
+            mergedRuns.push_back(move(merged));
+        }
+        if (runs.size() % 2 == 1) {
+            mergedRuns.push_back(move(runs.back()));
+        }
+        runs = move(mergedRuns);
+    }
+    return move(runs.front());
 }
 
-// Test Case 3: Generate arrays of varying sizes
-vector<int> generateScalabilityArray(int size) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
-    uniform_int_distribution<> distribution(0, 10000);
+// ============================================================================
+// PARALLEL STABLE MERGE SORT (MERGE PATH)
+// ============================================================================
+// Time Complexity: O((n / T) log n + n log T / T) with T threads
+// Space Complexity: O(n) - one ping-pong buffer
+// Stability: Yes - stable leaves and stable merges, left run wins ties
+// Best for: Key types the radix engines cannot handle (strings, custom
+//           comparators) when stability is required
+// The array is cut into T leaves that are sorted concurrently. Runs are then
+// merged pairwise; each pair's output is split into T equal diagonals and the
+// merge path gives every thread the exact input ranges for its diagonal.
+// Leaves and the merge buffer reserve their scratch from MemoryBudget; when
+// refused they fall back to the buffer-free rotation merge below, which is
+// O(n log^2 n) but needs only O(log n) stack.
 
-    for (int i = 0; i < size; i++) {
-        result[i] = distribution(generator);
+// Number of elements taken from a among the first `diagonal` outputs of a
+// stable merge of a and b
+template<typename T, typename Compare>
+size_t mergePathSplit(const T* a, size_t aSize, const T* b, size_t bSize, size_t diagonal, Compare less) {
+    size_t low = diagonal > bSize ? diagonal - bSize : 0;
+    size_t high = min(diagonal, aSize);
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (!less(b[diagonal - middle - 1], a[middle])) low = middle + 1;
+        else high = middle;
     }
-    return result;
+    return low;
 }
 
-// Test Case 4: Generate worst case for bucket sort (all elements in one bucket)
-vector<int> generateWorstCaseBucketSort(int size) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
-    // Small range causes all elements to fall into same/few buckets
-    uniform_int_distribution<> distribution(0, 10);
+// Stable merge of [first, middle) and [middle, last) without a buffer: cut
+// the longer run in half, find the matching cut in the other run, rotate the
+// middle parts together and merge each side
+template<typename Iterator, typename Compare>
+void mergeInPlaceByRotation(Iterator first, Iterator middle, Iterator last, Compare less) {
+    if (first == middle || middle == last) return;
+    if (!less(*middle, *(middle - 1))) return;
+    if (last - first == 2) {
+        iter_swap(first, middle);
+        return;
+    }
+    Iterator leftCut;
+    Iterator rightCut;
+    if (middle - first >= last - middle) {
+        leftCut = first + (middle - first) / 2;
+        rightCut = lower_bound(middle, last, *leftCut, less);
+    }
+    else {
+        rightCut = middle + (last - middle) / 2;
+        leftCut = upper_bound(first, middle, *rightCut, less);
+    }
+    Iterator newMiddle = leftCut + (rightCut - middle);
+    rotate(leftCut, middle, rightCut);
+    mergeInPlaceByRotation(first, leftCut, newMiddle, less);
+    mergeInPlaceByRotation(newMiddle, rightCut, last, less);
+}
 
-    for (int i = 0; i < size; i++) {
-        result[i] = distribution(generator);
+// Stable sort with no scratch: insertion-sorted blocks, then rotation merges
+template<typename Iterator, typename Compare>
+void stableSortInPlace(Iterator first, Iterator last, Compare less) {
+    const ptrdiff_t INSERTION_SORT_CUTOFF = 16;
+    if (last - first <= INSERTION_SORT_CUTOFF) {
+        for (Iterator it = first + (first != last); it < last; ++it) {
+            for (Iterator hole = it; hole != first && less(*hole, *(hole - 1)); --hole) {
+                iter_swap(hole, hole - 1);
+            }
+        }
+        return;
     }
-    return result;
+    Iterator middle = first + (last - first) / 2;
+    stableSortInPlace(first, middle, less);
+    stableSortInPlace(middle, last, less);
+    mergeInPlaceByRotation(first, middle, last, less);
 }
 
-// Test Case 5: Generate large range with few repeated values
-vector<int> generateLargeRangeFewRepeats(int size) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
-    // Very large range relative to array size
-    uniform_int_distribution<> distribution(0, 1000000);
+template<typename T, typename Compare, typename LeafSort>
+void parallelStableMergeSort(vector<T>& values, Compare less, int threadCount, LeafSort sortLeaf) {
+    size_t n = values.size();
+    if (n < 2) return;
+    threadCount = max(1, min(threadCount, static_cast<int>(n)));
 
-    for (int i = 0; i < size; i++) {
-        result[i] = distribution(generator);
+    // Leaves: T contiguous chunks, each sorted by the supplied stable engine
+    vector<size_t> runStart;
+    for (int t = 0; t <= threadCount; t++) {
+        runStart.push_back(n * t / threadCount);
+    }
+    runOnThreads(threadCount, [&](int t) {
+        sortLeaf(values.begin() + runStart[t], values.begin() + runStart[t + 1]);
+    });
+
+    // Without budget for the n-sized buffer, merge the runs in place
+    ScratchReservation scratch(n * sizeof(T), false);
+    if (!scratch.granted()) {
+        MemoryBudget::instance().recordDowngrade();
+        while (runStart.size() > 2) {
+            vector<size_t> mergedStart;
+            for (size_t r = 0; r + 1 < runStart.size(); r += 2) {
+                mergedStart.push_back(runStart[r]);
+            }
+            mergedStart.push_back(n);
+            runOnThreads(threadCount, [&](int t) {
+                for (size_t r = 2 * t; r + 2 < runStart.size(); r += 2 * threadCount) {
+                    mergeInPlaceByRotation(values.begin() + runStart[r], values.begin() + runStart[r + 1],
+                        values.begin() + runStart[r + 2], less);
+                }
+            });
+            runStart.swap(mergedStart);
+        }
+        return;
+    }
+
+    vector<T> buffer(n);
+    vector<T>* source = &values;
+    vector<T>* target = &buffer;
+    while (runStart.size() > 2) {
+        // Every thread takes diagonal slice t of every pair of runs
+        runOnThreads(threadCount, [&](int t) {
+            for (size_t r = 0; r + 1 < runStart.size(); r += 2) {
+                const T* a = source->data() + runStart[r];
+                size_t aSize = runStart[r + 1] - runStart[r];
+                size_t bSize = r + 2 < runStart.size() ? runStart[r + 2] - runStart[r + 1] : 0;
+                const T* b = a + aSize;
+                size_t total = aSize + bSize;
+                size_t firstDiagonal = total * t / threadCount;
+                size_t lastDiagonal = total * (t + 1) / threadCount;
+                size_t aFirst = mergePathSplit(a, aSize, b, bSize, firstDiagonal, less);
+                size_t aLast = mergePathSplit(a, aSize, b, bSize, lastDiagonal, less);
+                merge(a + aFirst, a + aLast, b + (firstDiagonal - aFirst), b + (lastDiagonal - aLast),
+                    target->begin() + runStart[r] + firstDiagonal, less);
+            }
+        });
+
+        vector<size_t> mergedStart;
+        for (size_t r = 0; r + 1 < runStart.size(); r += 2) {
+            mergedStart.push_back(runStart[r]);
+        }
+        mergedStart.push_back(n);
+        runStart.swap(mergedStart);
+        swap(source, target);
+    }
+    if (source != &values) {
+        values.swap(buffer);
     }
-    return result;
 }
 
-// Test Case 6: Generate array with many duplicate values
-vector<int> generateManyDuplicates(int size) {
-    vector<int> result(size);
-    random_device randomDevice;
-    mt19937 generator(randomDevice());
-    // Only 10 possible values, causing many duplicates
-    uniform_int_distribution<> distribution(0, 9);
+// Generic stable version: leaves are sorted with std::stable_sort, whose
+// temporary buffer is reserved first
+template<typename T, typename Compare>
+void parallelStableMergeSort(vector<T>& values, Compare less, int threadCount) {
+    typedef typename vector<T>::iterator Iterator;
+    parallelStableMergeSort(values, less, threadCount, [&](Iterator first, Iterator last) {
+        ScratchReservation leafScratch((last - first) * sizeof(T), false);
+        if (leafScratch.granted()) stable_sort(first, last, less);
+        else stableSortInPlace(first, last, less);
+    });
+}
+
+// Integer version: leaves are sorted with the stable byte-wise radix engine,
+// which needs a leaf copy plus its scatter buffer
+void parallelStableMergeSort(vector<int>& array, int threadCount) {
+    typedef vector<int>::iterator Iterator;
+    parallelStableMergeSort(array, less<int>(), threadCount, [](Iterator first, Iterator last) {
+        ScratchReservation leafScratch(2 * (last - first) * sizeof(int), false);
+        if (!leafScratch.granted()) {
+            stableSortInPlace(first, last, less<int>());
+            return;
+        }
+        vector<int> leaf(first, last);
+        radixSortByteLSDUnbudgeted(leaf, [](int value) { return radixKeyOf(value); });
+        copy(leaf.begin(), leaf.end(), first);
+    });
+}
+
+// ============================================================================
+// MERGING A DELTA INTO A SORTED ARRAY
+// ============================================================================
+// Time Complexity: O(n + d log d + t log t) at worst, O(n + d + t) when the
+//                  delta and tombstones fall to the counting/radix engines
+// Space Complexity: O(d + t) beyond the grown base array
+// Stability: Existing elements keep their order; new equal keys go after them
+// Best for: Large sorted arrays receiving small batches of inserts/deletes,
+//           instead of appending and re-running a full sort
+// Each tombstone removes one occurrence of its key from base + delta; keys
+// that are not present are ignored. Returns the number of elements removed.
+// With tombstones the base is read twice: a forward compaction removes them
+// before the back-to-front merge, which could otherwise overwrite unread keys
+// once more keys are removed than inserted.
+
+// Sort a small batch with the cheapest engine for its value range
+void sortBatch(vector<int>& batch) {
+    if (batch.size() < 2) return;
+    long long minValue = *min_element(batch.begin(), batch.end());
+    long long maxValue = *max_element(batch.begin(), batch.end());
+    if (maxValue - minValue < tuningProfile().countingRangeFactor * batch.size()) {
+        countingSortNonStable(batch);
+    }
+    else {
+        radixSortByteLSD(batch, [](int value) { return radixKeyOf(value); });
+    }
+}
+
+size_t mergeDeltaIntoSorted(vector<int>& sortedBase, vector<int> delta, vector<int> tombstones = vector<int>()) {
+    sortBatch(delta);
+    sortBatch(tombstones);
+    size_t removed = 0;
+
+    // Tombstones first cancel matching keys of the delta...
+    if (!tombstones.empty() && !delta.empty()) {
+        vector<int> survivingDelta;
+        vector<int> survivingTombstones;
+        set_difference(delta.begin(), delta.end(), tombstones.begin(), tombstones.end(),
+            back_inserter(survivingDelta));
+        set_difference(tombstones.begin(), tombstones.end(), delta.begin(), delta.end(),
+            back_inserter(survivingTombstones));
+        removed += delta.size() - survivingDelta.size();
+        delta.swap(survivingDelta);
+        tombstones.swap(survivingTombstones);
+    }
+
+    // ...then the rest are removed from the base in one forward compaction
+    if (!tombstones.empty()) {
+        size_t writeIndex = 0;
+        size_t tombstoneIndex = 0;
+        for (size_t readIndex = 0; readIndex < sortedBase.size(); readIndex++) {
+            int value = sortedBase[readIndex];
+            while (tombstoneIndex < tombstones.size() && tombstones[tombstoneIndex] < value) {
+                tombstoneIndex++;
+            }
+            if (tombstoneIndex < tombstones.size() && tombstones[tombstoneIndex] == value) {
+                tombstoneIndex++;
+                removed++;
+                continue;
+            }
+            sortedBase[writeIndex++] = value;
+        }
+        sortedBase.resize(writeIndex);
+    }
+
+    // Merge from the back so the base never has to be copied; growing the
+    // vector reallocates only when its capacity is too small
+    size_t baseSize = sortedBase.size();
+    sortedBase.resize(baseSize + delta.size());
+    size_t baseIndex = baseSize;
+    size_t deltaIndex = delta.size();
+    size_t writeIndex = sortedBase.size();
+    while (deltaIndex > 0) {
+        if (baseIndex > 0 && sortedBase[baseIndex - 1] > delta[deltaIndex - 1]) {
+            sortedBase[--writeIndex] = sortedBase[--baseIndex];
+        }
+        else {
+            sortedBase[--writeIndex] = delta[--deltaIndex];
+        }
+    }
+    return removed;
+}
+
+// ============================================================================
+// STREAMING SORTER (CONCURRENT MULTI-PRODUCER)
+// ============================================================================
+// Ingest: O(1) per push, no locks unless a chunk fills up
+// Background: full chunks are sorted with radixSortByteLSD and kept as sorted
+//             runs; when more than maxRuns exist, the two smallest are merged
+// Snapshot: O(t + m log r + n) where t is the unsorted tail, m the keys
+//           in the r runs finished since the previous snapshot, and n the
+//           total size. Finished runs are folded into a persistent sorted
+//           prefix, so older data costs only a linear merge and copy.
+// Keys: any int (byte radix on the sign-flipped key)
+class StreamingSorter {
+public:
+    // Ingest handle owned by exactly one writer thread. push() only writes into
+    // this producer's chunk and publishes the new count with a release store,
+    // so snapshot() can copy the filled prefix without stopping the writer.
+    class Producer {
+    public:
+        void push(int value) {
+            size_t count = publishedCount.load(memory_order_relaxed);
+            chunk[count] = value;
+            publishedCount.store(count + 1, memory_order_release);
+            if (count + 1 == chunk.size()) {
+                owner->submitFullChunk(*this);
+            }
+        }
+
+    private:
+        friend class StreamingSorter;
+        Producer(StreamingSorter* sorter, size_t chunkSize)
+            : owner(sorter), chunk(chunkSize), publishedCount(0) {}
+
+        StreamingSorter* owner;
+        vector<int> chunk;
+        atomic<size_t> publishedCount;
+    };
+
+    explicit StreamingSorter(int workerCount = 1, size_t chunkSize = 4096, size_t maxRuns = 8)
+        : chunkSize(max<size_t>(1, chunkSize)), maxRuns(max<size_t>(1, maxRuns)) {
+        for (int i = 0; i < max(1, workerCount); i++) {
+            workers.push_back(thread(&StreamingSorter::workerLoop, this));
+        }
+    }
+
+    ~StreamingSorter() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    StreamingSorter(const StreamingSorter&) = delete;
+    StreamingSorter& operator=(const StreamingSorter&) = delete;
+
+    // Register a new writer; the returned producer lives as long as the sorter
+    Producer& createProducer() {
+        lock_guard<mutex> lock(stateMutex);
+        producers.push_back(unique_ptr<Producer>(new Producer(this, chunkSize)));
+        return *producers.back();
+    }
+
+    // Sorted copy of everything pushed so far. Waits only for the background
+    // job currently in flight. Runs finished since the last snapshot are taken
+    // from the workers and merged into the sorted prefix; the unsorted tail
+    // (queued chunks plus partially filled producer chunks) is sorted here and
+    // merged with the prefix into the result.
+    vector<int> snapshot() {
+        lock_guard<mutex> prefixLock(prefixMutex);
+        vector<vector<int>> newRuns;
+        vector<int> unsortedTail;
+        {
+            unique_lock<mutex> lock(stateMutex);
+            snapshotsWaiting++;
+            jobFinished.wait(lock, [this] { return activeJobs == 0; });
+            snapshotsWaiting--;
+
+            newRuns.swap(runs);
+            for (const auto& chunk : pendingChunks) {
+                unsortedTail.insert(unsortedTail.end(), chunk.begin(), chunk.end());
+            }
+            for (const auto& producer : producers) {
+                size_t count = producer->publishedCount.load(memory_order_acquire);
+                unsortedTail.insert(unsortedTail.end(), producer->chunk.begin(), producer->chunk.begin() + count);
+            }
+        }
+        workAvailable.notify_all();
+
+        if (!newRuns.empty()) {
+            vector<int> newKeys = mergeSortedRuns(move(newRuns));
+            vector<int> grownPrefix(mergedPrefix.size() + newKeys.size());
+            merge(mergedPrefix.begin(), mergedPrefix.end(), newKeys.begin(), newKeys.end(), grownPrefix.begin());
+            mergedPrefix.swap(grownPrefix);
+        }
+
+        radixSortByteLSD(unsortedTail, [](int value) { return radixKeyOf(value); });
+        vector<int> result(mergedPrefix.size() + unsortedTail.size());
+        merge(mergedPrefix.begin(), mergedPrefix.end(), unsortedTail.begin(), unsortedTail.end(), result.begin());
+        return result;
+    }
+
+    // Number of sorted runs currently held by the background workers
+    size_t runCount() {
+        lock_guard<mutex> lock(stateMutex);
+        return runs.size();
+    }
+
+private:
+    // Slow path of Producer::push: hand the full chunk to the workers
+    void submitFullChunk(Producer& producer) {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            pendingChunks.push_back(move(producer.chunk));
+            producer.chunk = vector<int>(chunkSize);
+            producer.publishedCount.store(0, memory_order_release);
+        }
+        workAvailable.notify_one();
+    }
+
+    void workerLoop() {
+        unique_lock<mutex> lock(stateMutex);
+        while (true) {
+            // New jobs are held back while a snapshot waits, bounding its latency
+            workAvailable.wait(lock, [this] {
+                return stopping || (snapshotsWaiting == 0 && (!pendingChunks.empty() || runs.size() > maxRuns));
+            });
+
+            if (snapshotsWaiting == 0 && !pendingChunks.empty()) {
+                vector<int> chunk = move(pendingChunks.front());
+                pendingChunks.pop_front();
+                activeJobs++;
+                lock.unlock();
+                radixSortByteLSD(chunk, [](int value) { return radixKeyOf(value); });
+                lock.lock();
+                runs.push_back(move(chunk));
+                activeJobs--;
+            }
+            else if (snapshotsWaiting == 0 && runs.size() > maxRuns) {
+                // Merge the two smallest runs so merge cost stays proportional
+                sort(runs.begin(), runs.end(), [](const vector<int>& a, const vector<int>& b) {
+                    return a.size() > b.size();
+                });
+                vector<int> first = move(runs.back());
+                runs.pop_back();
+                vector<int> second = move(runs.back());
+                runs.pop_back();
+                activeJobs++;
+                lock.unlock();
+                vector<int> merged(first.size() + second.size());
+                merge(first.begin(), first.end(), second.begin(), second.end(), merged.begin());
+                lock.lock();
+                runs.push_back(move(merged));
+                activeJobs--;
+            }
+            else if (stopping) {
+                break;
+            }
+            jobFinished.notify_all();
+        }
+    }
+
+    const size_t chunkSize;
+    const size_t maxRuns;
+
+    mutex stateMutex;
+    condition_variable workAvailable;
+    condition_variable jobFinished;
+    vector<unique_ptr<Producer>> producers;
+    deque<vector<int>> pendingChunks;
+    vector<vector<int>> runs;
+    int activeJobs = 0;
+    int snapshotsWaiting = 0;
+    bool stopping = false;
+    vector<thread> workers;
+
+    // Sorted union of every run handed over to snapshot(); guarded by prefixMutex
+    mutex prefixMutex;
+    vector<int> mergedPrefix;
+};
+
+// ============================================================================
+// APPLYING A PERMUTATION
+// ============================================================================
+// sourceIndex[i] names the element that must end up at position i.
+// applyPermutation: O(n) time, O(n) extra space - one gather pass into a new
+//                   buffer, prefetching the source a few elements ahead
+// applyPermutationInPlace: O(n) time, O(n) extra bits - follows each cycle of
+//                   the permutation once, marking visited slots in a bitset
+const size_t GATHER_PREFETCH_DISTANCE = 8;
+
+template<typename T>
+void applyPermutationInPlace(vector<T>& values, const vector<uint32_t>& sourceIndex);
+
+template<typename T>
+void applyPermutation(vector<T>& values, const vector<uint32_t>& sourceIndex) {
+    // Reserve the gather buffer; without budget, follow the cycles in place.
+    // The in-place variant's n bits are not reserved, so a caller that already
+    // holds a reservation never queues here.
+    ScratchReservation scratch(values.size() * sizeof(T), false);
+    if (!scratch.granted()) {
+        MemoryBudget::instance().recordDowngrade();
+        applyPermutationInPlace(values, sourceIndex);
+        return;
+    }
+    vector<T> outputArray;
+    outputArray.reserve(values.size());
+    for (size_t i = 0; i < sourceIndex.size(); i++) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (i + GATHER_PREFETCH_DISTANCE < sourceIndex.size()) {
+            __builtin_prefetch(&values[sourceIndex[i + GATHER_PREFETCH_DISTANCE]]);
+        }
+#endif
+        outputArray.push_back(values[sourceIndex[i]]);
+    }
+    values.swap(outputArray);
+}
+
+template<typename T>
+void applyPermutationInPlace(vector<T>& values, const vector<uint32_t>& sourceIndex) {
+    vector<bool> visited(values.size(), false);
+    for (size_t start = 0; start < values.size(); start++) {
+        if (visited[start]) continue;
+
+        // Rotate the cycle containing start: each slot pulls from its source
+        T displaced = move(values[start]);
+        size_t position = start;
+        while (true) {
+            visited[position] = true;
+            size_t source = sourceIndex[position];
+            if (source == start) {
+                values[position] = move(displaced);
+                break;
+            }
+            values[position] = move(values[source]);
+            position = source;
+        }
+    }
+}
+
+// ============================================================================
+// INDIRECT SORT (LARGE RECORDS)
+// ============================================================================
+// Time Complexity: O(p * n) radix passes over 8-byte (key, index) pairs,
+//                  plus one pass that moves each record exactly once
+// Space Complexity: O(n) pairs, plus O(n) records for the gather variant
+//                   or O(n) bits for the in-place variant
+// Stability: Yes - the radix engine is stable on (key, index) pairs
+// Best for: Records of 64+ bytes, where moving whole records through every
+//           radix pass costs far more than moving 8-byte pairs
+// Record count must fit in 32 bits.
+struct KeyIndexPair {
+    uint32_t key;
+    uint32_t index;
+};
+
+// Sort order of the records as a source-index permutation
+template<typename Record, typename KeyFunction>
+vector<uint32_t> sortedPermutation(const vector<Record>& records, KeyFunction keyOf) {
+    vector<KeyIndexPair> pairs(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        pairs[i].key = radixKeyOf(keyOf(records[i]));
+        pairs[i].index = static_cast<uint32_t>(i);
+    }
+    radixSortByteLSD(pairs, [](const KeyIndexPair& pair) { return pair.key; });
+
+    vector<uint32_t> sourceIndex(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        sourceIndex[i] = pairs[i].index;
+    }
+    return sourceIndex;
+}
+
+template<typename Record, typename KeyFunction>
+void indirectSort(vector<Record>& records, KeyFunction keyOf, bool inPlace = false) {
+    if (records.size() < 2) return;
+    vector<uint32_t> sourceIndex = sortedPermutation(records, keyOf);
+    if (inPlace) {
+        applyPermutationInPlace(records, sourceIndex);
+    }
+    else {
+        applyPermutation(records, sourceIndex);
+    }
+}
+
+// ============================================================================
+// SPACE-FILLING CURVE SORT (MORTON / HILBERT)
+// ============================================================================
+// Time Complexity: O(n * d) to compute codes + O(p * n) radix passes over
+//                  (code, index) pairs + one gather, p = non-constant code bytes
+// Space Complexity: O(n)
+// Stability: Yes - points with equal codes keep their input order
+// Best for: Ordering 2D/3D point clouds and geo-coordinates for spatial
+//           locality before tiling or building spatial indexes
+// Coordinates are first quantized to unsigned integers (quantizeCoordinate).
+// Morton codes interleave coordinate bits, using BMI2 pdep when the compiler
+// targets it (-mbmi2 / -march=native) and shift-and-mask spreading otherwise.
+// Hilbert codes (2D) keep neighbours on the curve adjacent in space, so they
+// give better locality at a few more operations per point.
+
+// Map value in [minValue, maxValue] onto [0, 2^bits - 1], bits in [1, 32]
+inline uint32_t quantizeCoordinate(double value, double minValue, double maxValue, int bits) {
+    bits = max(1, min(32, bits));
+    double cells = static_cast<double>((1ULL << bits) - 1);
+    double scaled = (value - minValue) / (maxValue - minValue) * cells;
+    return static_cast<uint32_t>(max(0.0, min(cells, scaled)));
+}
+
+// Spread the 32 bits of value to the even bit positions of a 64-bit word
+inline uint64_t spreadBits2D(uint32_t value) {
+    uint64_t spread = value;
+    spread = (spread | (spread << 16)) & 0x0000FFFF0000FFFFULL;
+    spread = (spread | (spread << 8)) & 0x00FF00FF00FF00FFULL;
+    spread = (spread | (spread << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    spread = (spread | (spread << 2)) & 0x3333333333333333ULL;
+    spread = (spread | (spread << 1)) & 0x5555555555555555ULL;
+    return spread;
+}
+
+// Spread the low 21 bits of value to every third bit position
+inline uint64_t spreadBits3D(uint32_t value) {
+    uint64_t spread = value & 0x1FFFFF;
+    spread = (spread | (spread << 32)) & 0x001F00000000FFFFULL;
+    spread = (spread | (spread << 16)) & 0x001F0000FF0000FFULL;
+    spread = (spread | (spread << 8)) & 0x100F00F00F00F00FULL;
+    spread = (spread | (spread << 4)) & 0x10C30C30C30C30C3ULL;
+    spread = (spread | (spread << 2)) & 0x1249249249249249ULL;
+    return spread;
+}
+
+// 64-bit Morton code of two 32-bit coordinates (x in the low bit of each pair)
+inline uint64_t mortonCode2D(uint32_t x, uint32_t y) {
+#ifdef __BMI2__
+    return _pdep_u64(x, 0x5555555555555555ULL) | _pdep_u64(y, 0xAAAAAAAAAAAAAAAAULL);
+#else
+    return spreadBits2D(x) | (spreadBits2D(y) << 1);
+#endif
+}
+
+// 63-bit Morton code of three 21-bit coordinates
+inline uint64_t mortonCode3D(uint32_t x, uint32_t y, uint32_t z) {
+#ifdef __BMI2__
+    return _pdep_u64(x, 0x1249249249249249ULL) | _pdep_u64(y, 0x2492492492492492ULL) |
+        _pdep_u64(z, 0x4924924924924924ULL);
+#else
+    return spreadBits3D(x) | (spreadBits3D(y) << 1) | (spreadBits3D(z) << 2);
+#endif
+}
+
+// The Hilbert curve as a 4-state machine (swap x/y, complement x and y)
+// stepped 4 bits of each coordinate at a time. Entry
+// [state][x chunk][y chunk] holds 8 code bits and the next state in bits 8-9.
+inline const vector<uint16_t>& hilbertChunkTable() {
+    static const vector<uint16_t> table = []() {
+        vector<uint16_t> entries(4 * 256);
+        for (int state = 0; state < 4; state++) {
+            for (uint32_t xChunk = 0; xChunk < 16; xChunk++) {
+                for (uint32_t yChunk = 0; yChunk < 16; yChunk++) {
+                    uint32_t swapped = state & 1;
+                    uint32_t complemented = state >> 1;
+                    uint32_t code = 0;
+                    for (int bit = 3; bit >= 0; bit--) {
+                        uint32_t right = ((xChunk >> bit) & 1) ^ complemented;
+                        uint32_t up = ((yChunk >> bit) & 1) ^ complemented;
+                        if (swapped) swap(right, up);
+                        code = (code << 2) | ((3 * right) ^ up);
+                        // Rotate the quadrant so the sub-curve starts and ends in the right corners
+                        if (up == 0) {
+                            swapped ^= 1;
+                            complemented ^= right;
+                        }
+                    }
+                    entries[state * 256 + xChunk * 16 + yChunk] =
+                        static_cast<uint16_t>(code | ((swapped | (complemented << 1)) << 8));
+                }
+            }
+        }
+        return entries;
+    }();
+    return table;
+}
+
+// Distance along the Hilbert curve covering a 2^order x 2^order grid. The
+// order is clamped to [1, 32]: x and y hold at most 32 bits per axis, and
+// order 0 would shift the coordinates by their full width.
+inline uint64_t hilbertCode2D(uint32_t x, uint32_t y, int order = 32) {
+    const vector<uint16_t>& table = hilbertChunkTable();
+    order = max(1, min(32, order));
+    // Walk the order-32 curve; the low 2 * (32 - order) code bits then belong
+    // to the cells below the requested resolution and are shifted out
+    int unusedBits = 32 - order;
+    x <<= unusedBits;
+    y <<= unusedBits;
+    uint64_t distance = 0;
+    uint32_t state = 0;
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        uint16_t entry = table[state * 256 + ((x >> shift) & 0xF) * 16 + ((y >> shift) & 0xF)];
+        distance = (distance << 8) | (entry & 0xFF);
+        state = entry >> 8;
+    }
+    return distance >> (2 * unusedBits);
+}
+
+struct CurveCodeIndex {
+    uint64_t code;
+    uint32_t index;
+};
+
+// Sort records by codeOf(record) with the radix engine on (code, index)
+// pairs, then move each record once; codes are computed exactly once
+template<typename Record, typename CodeFunction>
+void sortByCurveCode(vector<Record>& records, CodeFunction codeOf) {
+    if (records.size() < 2) return;
+
+    // Reserve the pairs, the radix buffer and the index; without budget, sort
+    // the records stably in place, recomputing codes in each comparison
+    size_t n = records.size();
+    ScratchReservation scratch(n * (2 * sizeof(CurveCodeIndex) + sizeof(uint32_t)), false);
+    if (!scratch.granted()) {
+        MemoryBudget::instance().recordDowngrade();
+        stableSortInPlace(records.begin(), records.end(), [&](const Record& a, const Record& b) {
+            return codeOf(a) < codeOf(b);
+        });
+        return;
+    }
+
+    vector<CurveCodeIndex> pairs(n);
+    for (size_t i = 0; i < n; i++) {
+        pairs[i].code = codeOf(records[i]);
+        pairs[i].index = static_cast<uint32_t>(i);
+    }
+    radixSortByteLSDUnbudgeted(pairs, [](const CurveCodeIndex& pair) { return pair.code; });
+
+    vector<uint32_t> sourceIndex(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        sourceIndex[i] = pairs[i].index;
+    }
+    applyPermutation(records, sourceIndex);
+}
+
+// ============================================================================
+// COLUMNAR SORT (STRUCT-OF-ARRAYS REORDER)
+// ============================================================================
+// Time Complexity: O(p * n) to sort the key column once, then O(n * c) to
+//                  reorder c payload columns, spread across threads
+// Space Complexity: O(n) indices, plus a second copy of each column for the
+//                   gather variant or O(n) bits for the in-place variant
+// Stability: Yes - rows with equal keys keep their original order
+// Best for: One key column with many payload columns that must follow it
+const size_t COLUMN_GATHER_BLOCK = 4096;
+
+// Reorder every column by the same permutation. Columns are split across
+// threads; each thread walks the permutation in blocks and gathers the block
+// for all of its columns, so the index block is reused while cache-resident.
+template<typename T>
+void applyPermutationToColumns(vector<vector<T>>& columns, const vector<uint32_t>& sourceIndex,
+    int threadCount, bool inPlace) {
+    size_t n = sourceIndex.size();
+    threadCount = max(1, min(threadCount, static_cast<int>(columns.size())));
+
+    // Every thread gathers all of its columns at once, so the gather variant
+    // needs a second copy of every column; without budget, reorder in place
+    ScratchReservation scratch(inPlace ? 0 : columns.size() * n * sizeof(T), false);
+    if (!scratch.granted()) {
+        MemoryBudget::instance().recordDowngrade();
+        inPlace = true;
+    }
+
+    // Cycle decomposition is shared by all columns: find one leader per cycle
+    vector<size_t> cycleLeaders;
+    if (inPlace) {
+        vector<bool> visited(n, false);
+        for (size_t start = 0; start < n; start++) {
+            if (visited[start]) continue;
+            cycleLeaders.push_back(start);
+            for (size_t position = start; !visited[position]; position = sourceIndex[position]) {
+                visited[position] = true;
+            }
+        }
+    }
+
+    auto reorderColumns = [&](int threadId) {
+        vector<vector<T>*> ownedColumns;
+        for (size_t c = threadId; c < columns.size(); c += threadCount) {
+            ownedColumns.push_back(&columns[c]);
+        }
+
+        if (inPlace) {
+            for (vector<T>* column : ownedColumns) {
+                for (size_t start : cycleLeaders) {
+                    T displaced = move((*column)[start]);
+                    size_t position = start;
+                    while (sourceIndex[position] != start) {
+                        (*column)[position] = move((*column)[sourceIndex[position]]);
+                        position = sourceIndex[position];
+                    }
+                    (*column)[position] = move(displaced);
+                }
+            }
+            return;
+        }
+
+        vector<vector<T>> outputColumns(ownedColumns.size(), vector<T>(n));
+        for (size_t blockStart = 0; blockStart < n; blockStart += COLUMN_GATHER_BLOCK) {
+            size_t blockEnd = min(n, blockStart + COLUMN_GATHER_BLOCK);
+            for (size_t c = 0; c < ownedColumns.size(); c++) {
+                const vector<T>& column = *ownedColumns[c];
+                vector<T>& output = outputColumns[c];
+                for (size_t i = blockStart; i < blockEnd; i++) {
+                    output[i] = column[sourceIndex[i]];
+                }
+            }
+        }
+        for (size_t c = 0; c < ownedColumns.size(); c++) {
+            ownedColumns[c]->swap(outputColumns[c]);
+        }
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        workers.push_back(thread(reorderColumns, t));
+    }
+    reorderColumns(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Sort the key column once and make every payload column follow it
+template<typename T>
+void sortColumnsByKey(vector<int>& keyColumn, vector<vector<T>>& payloadColumns,
+    int threadCount = 1, bool inPlace = false) {
+    if (keyColumn.size() < 2) return;
+    vector<uint32_t> sourceIndex = sortedPermutation(keyColumn, [](int key) { return key; });
+    applyPermutation(keyColumn, sourceIndex);
+    applyPermutationToColumns(payloadColumns, sourceIndex, threadCount, inPlace);
+}
+
+// ============================================================================
+// GROUPING BY KEY (CSR BUILDER)
+// ============================================================================
+// Time Complexity: O(n + T * K) for n pairs, K distinct keys, T threads;
+//                  plus O(g log g) per group when sorting within groups
+// Space Complexity: O(n + T * K)
+// Stability: Yes - each group keeps the input order of its values
+// Best for: Building graph adjacency (CSR) from an edge list or an inverted
+//           index from (term, document) pairs
+// This is the stable counting sort by key that countingSortStable runs
+// internally, with the cumulative counts kept as the group offsets. Keys
+// must lie in [0, keyCount). Threads count and scatter their own slices; the
+// thread count is capped so the T x K histograms never exceed the input size.
+
+struct GroupedValues {
+    vector<size_t> offsets;    // keyCount + 1 entries; group k is values[offsets[k] .. offsets[k + 1])
+    vector<uint32_t> values;
+};
+
+// Threads used for n pairs over K keys: T x K histograms stay within n
+inline int groupingThreadCount(size_t n, size_t keyCount, int threadCount) {
+    if (keyCount == 0) return 1;
+    return max(1, min(threadCount, static_cast<int>(min<size_t>(n / keyCount, 1024))));
+}
+
+// Histograms, offsets and output of one grouping call
+inline size_t groupingBytes(size_t n, size_t keyCount, int threadCount) {
+    int threads = groupingThreadCount(n, keyCount, threadCount);
+    return n * sizeof(uint32_t) + (static_cast<size_t>(threads) + 1) * (keyCount + 1) * sizeof(size_t);
+}
+
+// groupByKey without the reservation, for callers that reserved it already
+GroupedValues groupByKeyUnbudgeted(const vector<uint32_t>& keys, const vector<uint32_t>& values, size_t keyCount,
+    int threadCount, bool sortWithinGroups) {
+    GroupedValues grouped;
+    size_t n = min(keys.size(), values.size());
+    grouped.offsets.assign(keyCount + 1, 0);
+    grouped.values.resize(n);
+    if (n == 0 || keyCount == 0) return grouped;
+    threadCount = groupingThreadCount(n, keyCount, threadCount);
+
+    // Per-thread histograms over contiguous slices
+    size_t slice = (n + threadCount - 1) / threadCount;
+    vector<size_t> counts(static_cast<size_t>(threadCount) * keyCount, 0);
+    runOnThreads(threadCount, [&](int t) {
+        size_t* count = &counts[t * keyCount];
+        for (size_t i = t * slice; i < min(n, (t + 1) * slice); i++) count[keys[i]]++;
+    });
+
+    // Key-major prefix sum: group offsets, and each thread's write cursor per key
+    size_t offset = 0;
+    for (size_t key = 0; key < keyCount; key++) {
+        grouped.offsets[key] = offset;
+        for (int t = 0; t < threadCount; t++) {
+            size_t groupShare = counts[t * keyCount + key];
+            counts[t * keyCount + key] = offset;
+            offset += groupShare;
+        }
+    }
+    grouped.offsets[keyCount] = offset;
+
+    runOnThreads(threadCount, [&](int t) {
+        size_t* cursor = &counts[t * keyCount];
+        for (size_t i = t * slice; i < min(n, (t + 1) * slice); i++) {
+            grouped.values[cursor[keys[i]]++] = values[i];
+        }
+    });
+
+    // Optional secondary order; a group belongs to the thread whose slice holds its first value
+    if (sortWithinGroups) {
+        runOnThreads(threadCount, [&](int t) {
+            auto groupStarts = grouped.offsets.begin();
+            size_t firstKey = lower_bound(groupStarts, groupStarts + keyCount, t * slice) - groupStarts;
+            size_t endKey = lower_bound(groupStarts, groupStarts + keyCount, (t + 1) * slice) - groupStarts;
+            for (size_t key = firstKey; key < endKey; key++) {
+                sort(grouped.values.begin() + grouped.offsets[key], grouped.values.begin() + grouped.offsets[key + 1]);
+            }
+        });
+    }
+    return grouped;
+}
+
+GroupedValues groupByKey(const vector<uint32_t>& keys, const vector<uint32_t>& values, size_t keyCount,
+    int threadCount = 1, bool sortWithinGroups = false) {
+    // Grouping has no in-place variant, so it queues for its memory
+    ScratchReservation scratch(groupingBytes(min(keys.size(), values.size()), keyCount, threadCount), true);
+    return groupByKeyUnbudgeted(keys, values, keyCount, threadCount, sortWithinGroups);
+}
+
+// CSR adjacency of a directed graph: neighbours of v are values[offsets[v] .. offsets[v + 1])
+GroupedValues buildCSR(const vector<pair<uint32_t, uint32_t>>& edges, size_t vertexCount, int threadCount = 1,
+    bool sortNeighbours = false) {
+    // One reservation for the split columns and the grouping, so this never
+    // waits for a second reservation while holding the first
+    ScratchReservation scratch(2 * edges.size() * sizeof(uint32_t) + groupingBytes(edges.size(), vertexCount, threadCount),
+        true);
+    vector<uint32_t> sources(edges.size()), targets(edges.size());
+    for (size_t e = 0; e < edges.size(); e++) {
+        sources[e] = edges[e].first;
+        targets[e] = edges[e].second;
+    }
+    return groupByKeyUnbudgeted(sources, targets, vertexCount, threadCount, sortNeighbours);
+}
+
+// ============================================================================
+// QUANTILE SKETCH (KLL)
+// ============================================================================
+// Update: O(1) amortized, Query: O(m log m) for m retained items
+// Space Complexity: O(k) items, independent of the stream length
+// Error: rank error about 1.7 / k with high probability (k = 200 gives ~1%)
+// Best for: Approximate percentiles over streams too large to sort or to
+//           histogram over a wide domain; sketches merge across threads/shards
+// Items live in levels of compactors; an item at level h stands for 2^h
+// stream items. A full level is sorted with the byte radix engine and every
+// other item (random odd/even offset) moves up a level. Lower levels get
+// geometrically smaller capacities (factor 2/3), as in Karnin, Lang and
+// Liberty's KLL sketch.
+
+class KllSketch {
+public:
+    explicit KllSketch(int accuracy = 200, unsigned seed = 1)
+        : k(max(8, accuracy)), levels(1), capacities(1, max(8, accuracy)), itemCount(0), generator(seed) {}
+
+    void update(int value) {
+        levels[0].push_back(value);
+        itemCount++;
+        if (levels[0].size() >= capacities[0]) compress(true);
+    }
+
+    // Absorb another sketch; the result summarises both streams
+    void merge(const KllSketch& other) {
+        if (other.levels.size() > levels.size()) {
+            levels.resize(other.levels.size());
+            updateCapacities();
+        }
+        for (size_t h = 0; h < other.levels.size(); h++) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        itemCount += other.itemCount;
+        compress(false);
+    }
+
+    // Smallest retained value whose estimated rank reaches fraction * count()
+    int quantile(double fraction) const {
+        vector<pair<int, uint64_t>> weighted = weightedItems();
+        if (weighted.empty()) return 0;
+        uint64_t target = static_cast<uint64_t>(max(0.0, min(1.0, fraction)) * itemCount);
+        uint64_t cumulative = 0;
+        for (const auto& item : weighted) {
+            cumulative += item.second;
+            if (cumulative > target) return item.first;
+        }
+        return weighted.back().first;
+    }
+
+    // Estimated fraction of stream items <= value
+    double rank(int value) const {
+        uint64_t below = 0;
+        for (size_t h = 0; h < levels.size(); h++) {
+            for (int item : levels[h]) {
+                if (item <= value) below += 1ULL << h;
+            }
+        }
+        return itemCount > 0 ? static_cast<double>(below) / itemCount : 0.0;
+    }
+
+    uint64_t count() const { return itemCount; }
+
+    size_t retainedItems() const {
+        size_t retained = 0;
+        for (const auto& level : levels) retained += level.size();
+        return retained;
+    }
+
+    size_t memoryBytes() const { return sizeof(*this) + retainedItems() * sizeof(int) + levels.size() * sizeof(vector<int>); }
+
+private:
+    // Top level holds k items; each level below holds 2/3 as many, at least 8.
+    // Recomputed only when the sketch grows a level.
+    void updateCapacities() {
+        capacities.resize(levels.size());
+        for (size_t h = 0; h < levels.size(); h++) {
+            double scaled = k * pow(2.0 / 3.0, static_cast<double>(levels.size() - 1 - h));
+            capacities[h] = max<size_t>(8, static_cast<size_t>(ceil(scaled)));
+        }
+    }
+
+    // After an update only level 0 grew, so the cascade stops at the first
+    // level with room; after a merge every level has to be checked.
+    void compress(bool stopAtFirstFit) {
+        for (size_t h = 0; h < levels.size(); h++) {
+            if (levels[h].size() < capacities[h]) {
+                if (stopAtFirstFit) break;
+                continue;
+            }
+            if (h + 1 == levels.size()) {
+                levels.push_back(vector<int>());
+                updateCapacities();
+            }
+            vector<int>& level = levels[h];
+            if (level.size() <= 64) {
+                // Short lower levels: insertion sort beats the radix passes
+                for (size_t i = 1; i < level.size(); i++) {
+                    int value = level[i];
+                    size_t j = i;
+                    for (; j > 0 && level[j - 1] > value; j--) level[j] = level[j - 1];
+                    level[j] = value;
+                }
+            } else {
+                radixSortByteLSD(level, [](int value) { return radixKeyOf(value); });
+            }
+            // An odd item out stays behind so the promoted weight is exact
+            size_t keep = level.size() % 2;
+            size_t offset = keep + (generator() & 1);
+            for (size_t i = offset; i < level.size(); i += 2) {
+                levels[h + 1].push_back(level[i]);
+            }
+            level.resize(keep);
+        }
+    }
+
+    // Retained items sorted by value, each with its weight 2^level
+    vector<pair<int, uint64_t>> weightedItems() const {
+        vector<pair<int, uint64_t>> weighted;
+        weighted.reserve(retainedItems());
+        for (size_t h = 0; h < levels.size(); h++) {
+            for (int item : levels[h]) weighted.push_back(make_pair(item, 1ULL << h));
+        }
+        radixSortByteLSD(weighted, [](const pair<int, uint64_t>& item) { return radixKeyOf(item.first); });
+        return weighted;
+    }
+
+    int k;
+    vector<vector<int>> levels;
+    vector<size_t> capacities;
+    uint64_t itemCount;
+    mt19937 generator;
+};
+
+// ============================================================================
+// STATIC SEARCH INDEX (EYTZINGER LAYOUT)
+// ============================================================================
+// Build: O(n) from an already sorted array
+// Lookup: O(log n), one cache line fetched per tree level with prefetching
+// Space: O(n) - keys in BFS order plus their positions in the sorted array
+// Best for: Many lower_bound / range queries over a sorted array that is
+//           too large for the cache
+class EytzingerIndex {
+public:
+    explicit EytzingerIndex(const vector<int>& sortedArray)
+        : layout(sortedArray.size() + 1), sortedPosition(sortedArray.size() + 1) {
+        size_t sortedIndex = 0;
+        build(sortedArray, sortedIndex, 1);
+    }
+
+    size_t size() const { return layout.size() - 1; }
+
+    // Position in the sorted array of the first element >= key (size() if none)
+    size_t lowerBound(int key) const {
+        return positionOf(descend(key, false));
+    }
+
+    // Position in the sorted array of the first element > key (size() if none)
+    size_t upperBound(int key) const {
+        return positionOf(descend(key, true));
+    }
+
+    // Number of elements with low <= value <= high
+    size_t countInRange(int low, int high) const {
+        if (low > high) return 0;
+        return upperBound(high) - lowerBound(low);
+    }
+
+    // lowerBound for many keys at once. Queries advance through the tree in
+    // lockstep groups so the memory latency of one query overlaps the others.
+    vector<size_t> lowerBoundBatch(const vector<int>& keys) const {
+        const size_t GROUP = 16;
+        const size_t n = size();
+        vector<size_t> positions(keys.size());
+        size_t node[GROUP];
+
+        for (size_t start = 0; start < keys.size(); start += GROUP) {
+            size_t groupSize = min(GROUP, keys.size() - start);
+            for (size_t q = 0; q < groupSize; q++) {
+                node[q] = 1;
+            }
+
+            bool anyActive = true;
+            while (anyActive) {
+                anyActive = false;
+                for (size_t q = 0; q < groupSize; q++) {
+                    size_t k = node[q];
+                    if (k > n) continue;
+                    prefetchNode(k);
+                    node[q] = 2 * k + (layout[k] < keys[start + q]);
+                    anyActive = true;
+                }
+            }
+
+            for (size_t q = 0; q < groupSize; q++) {
+                positions[start + q] = positionOf(finishDescent(node[q]));
+            }
+        }
+        return positions;
+    }
+
+private:
+    // In-order traversal of the implicit tree assigns sorted elements to slots
+    void build(const vector<int>& sortedArray, size_t& sortedIndex, size_t node) {
+        if (node > size()) return;
+        build(sortedArray, sortedIndex, 2 * node);
+        layout[node] = sortedArray[sortedIndex];
+        sortedPosition[node] = sortedIndex;
+        sortedIndex++;
+        build(sortedArray, sortedIndex, 2 * node + 1);
+    }
+
+    // Prefetch the node 4 levels below k: its 16 descendants share one cache line
+    void prefetchNode(size_t k) const {
+#if defined(__GNUC__) || defined(__clang__)
+        size_t target = 16 * k;
+        if (target < layout.size()) {
+            __builtin_prefetch(&layout[target]);
+        }
+#else
+        (void)k;
+#endif
+    }
+
+    // Walk down until falling off the tree; the answer is the last node where
+    // we went left, recovered by dropping the trailing right turns (1 bits)
+    size_t descend(int key, bool inclusive) const {
+        const size_t n = size();
+        size_t k = 1;
+        while (k <= n) {
+            prefetchNode(k);
+            k = 2 * k + (inclusive ? layout[k] <= key : layout[k] < key);
+        }
+        return finishDescent(k);
+    }
+
+    static size_t finishDescent(size_t k) {
+        while (k & 1) {
+            k >>= 1;
+        }
+        return k >> 1;
+    }
+
+    size_t positionOf(size_t node) const {
+        return node == 0 ? size() : sortedPosition[node];
+    }
+
+    vector<int> layout;            // keys in BFS order, slot 0 unused
+    vector<size_t> sortedPosition; // index of each slot's key in the sorted array
+};
+
+// ============================================================================
+// UTILITY FUNCTIONS FOR TESTING
+// ============================================================================
+
+// Print array contents (with limit for large arrays)
+void printArray(const vector<int>& array, const string& label, int maxElements = 20) {
+    cout << label << ": ";
+    int elementsToShow = min(static_cast<int>(array.size()), maxElements);
+    for (int i = 0; i < elementsToShow; i++) {
+        cout << array[i] << " ";
+    }
+    if (array.size() > static_cast<size_t>(maxElements)) {
+        cout << "... (" << array.size() << " total elements)";
+    }
+    cout << endl;
+}
+
+// Verify that an array is sorted correctly
+bool isSorted(const vector<int>& array) {
+    for (size_t i = 1; i < array.size(); i++) {
+        if (array[i] < array[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Measure execution time of a sorting algorithm
+template<typename SortFunction>
+double measureSortingTime(vector<int> array, SortFunction sortFunc, const string& algorithmName) {
+    auto startTime = high_resolution_clock::now();
+    sortFunc(array);
+    auto endTime = high_resolution_clock::now();
+
+    duration<double, milli> executionTime = endTime - startTime;
+
+    // Verify the sort was successful
+    if (!isSorted(array)) {
+        cout << "ERROR: " << algorithmName << " did not sort correctly!" << endl;
+    }
+
+    return executionTime.count();
+}
+
+// Generate test array
+vector<int> generateTestArray() {
+    return { 170, 45, 75, 90, 802, 24, 2, 66 };
+}
+
+// ============================================================================
+// TEST CASE GENERATORS
+// ============================================================================
+// Every generator is seeded, so repeated runs sort identical inputs; call
+// sites that need several independent arrays pass their own seed.
+const unsigned TEST_CASE_SEED = 2024;
+
+// Test Case 1: Generate arrays with varying range sizes
+vector<int> generateVaryingRangeArray(int size, int maxRange, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    uniform_int_distribution<> distribution(0, maxRange);
+
+    for (int i = 0; i < size; i++) {
+        result[i] = distribution(generator);
+    }
+    return result;
+}
+
+// Test Case 2: Generate arrays with different distributions
+enum Distribution { UNIFORM, NORMAL, SKEWED, EXPONENTIAL };
+
+vector<int> generateDistributionArray(int size, Distribution distributionType, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+
+    switch (distributionType) {
+    case UNIFORM: {
+        uniform_int_distribution<> distribution(0, 1000);
+        for (int i = 0; i < size; i++) {
+            result[i] = distribution(generator);
+        }
+        break;
+    }
+    case NORMAL: {
+        normal_distribution<> distribution(500, 150);
+        for (int i = 0; i < size; i++) {
+            result[i] = max(0, min(1000, static_cast<int>(distribution(generator))));
+        }
+        break;
+    }
+    case SKEWED: {
+        // Right-skewed distribution (more small values)
+        exponential_distribution<> distribution(0.003);
+        for (int i = 0; i < size; i++) {
+            result[i] = min(1000, static_cast<int>(distribution(generator)));
+        }
+        break;
+    }
+    case EXPONENTIAL: {
+        exponential_distribution<> distribution(0.005);
+        for (int i = 0; i < size; i++) {
+            result[i] = min(1000, static_cast<int>(distribution(generator)));
+        }
+        break;
+    }
+    }
+    return result;
+}
+
+// Test Case 3: Generate arrays of varying sizes
+vector<int> generateScalabilityArray(int size, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    uniform_int_distribution<> distribution(0, 10000);
+
+    for (int i = 0; i < size; i++) {
+        result[i] = distribution(generator);
+    }
+    return result;
+}
+
+// Test Case 4: Generate worst case for bucket sort (all elements in one bucket)
+vector<int> generateWorstCaseBucketSort(int size, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    // Small range causes all elements to fall into same/few buckets
+    uniform_int_distribution<> distribution(0, 10);
+
+    for (int i = 0; i < size; i++) {
+        result[i] = distribution(generator);
+    }
+    return result;
+}
+
+// Test Case 5: Generate large range with few repeated values
+vector<int> generateLargeRangeFewRepeats(int size, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    // Very large range relative to array size
+    uniform_int_distribution<> distribution(0, 1000000);
+
+    for (int i = 0; i < size; i++) {
+        result[i] = distribution(generator);
+    }
+    return result;
+}
+
+// Test Case 6: Generate array with many duplicate values
+vector<int> generateManyDuplicates(int size, unsigned seed = TEST_CASE_SEED) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    // Only 10 possible values, causing many duplicates
+    uniform_int_distribution<> distribution(0, 9);
+
+    for (int i = 0; i < size; i++) {
+        result[i] = distribution(generator);
+    }
+    return result;
+}
+
+// Production-like input shapes. Unlike the generators above these take an
+// explicit seed, so the same (shape, size, parameters, seed) always produces
+// the same array, and several shapes span the full int range.
+enum InputShape {
+    SORTED, REVERSE_SORTED, NEARLY_SORTED, ORGAN_PIPE, SAWTOOTH, ZIPF,
+    ALL_EQUAL, FEW_DISTINCT_WIDE, NEGATIVE_HEAVY, CLUSTERED
+};
+
+const vector<InputShape> ALL_INPUT_SHAPES = {
+    SORTED, REVERSE_SORTED, NEARLY_SORTED, ORGAN_PIPE, SAWTOOTH, ZIPF,
+    ALL_EQUAL, FEW_DISTINCT_WIDE, NEGATIVE_HEAVY, CLUSTERED
+};
+
+// Shape-specific knobs; a value of 0 selects the default noted beside it
+struct ShapeParameters {
+    int swaps = 0;             // NEARLY_SORTED: random swaps (size / 100)
+    double zipfExponent = 0;   // ZIPF: exponent s (1.1)
+    int zipfRanks = 0;         // ZIPF: distinct ranks (min(size, 1,000,000))
+    int distinctValues = 0;    // FEW_DISTINCT_WIDE: distinct keys (16)
+    int teeth = 0;             // SAWTOOTH: number of ramps (16)
+    int clusters = 0;          // CLUSTERED: number of clusters (8)
+};
+
+string shapeName(InputShape shape) {
+    switch (shape) {
+    case SORTED: return "Sorted";
+    case REVERSE_SORTED: return "Reverse Sorted";
+    case NEARLY_SORTED: return "Nearly Sorted";
+    case ORGAN_PIPE: return "Organ Pipe";
+    case SAWTOOTH: return "Sawtooth";
+    case ZIPF: return "Zipf";
+    case ALL_EQUAL: return "All Equal";
+    case FEW_DISTINCT_WIDE: return "Few Distinct (Full Range)";
+    case NEGATIVE_HEAVY: return "Negative Heavy";
+    case CLUSTERED: return "Clustered";
+    }
+    return "Unknown";
+}
+
+// Bump whenever generateShapeArray produces different data for the same
+// arguments; the dataset cache keys its files on it so stale files are ignored
+const int SHAPE_GENERATOR_VERSION = 2;
+
+// Spacing of the ramps in ORGAN_PIPE and SAWTOOTH: 1000 per step, shrunk so
+// that the highest step still fits in an int
+int rampStep(int64_t highestStep) {
+    return static_cast<int>(max<int64_t>(1, min<int64_t>(1000, numeric_limits<int>::max() / max<int64_t>(1, highestStep))));
+}
+
+vector<int> generateShapeArray(InputShape shape, int size, unsigned seed,
+    const ShapeParameters& parameters = ShapeParameters()) {
+    vector<int> result(size);
+    mt19937 generator(seed);
+    uniform_int_distribution<int> fullRange(numeric_limits<int>::min(), numeric_limits<int>::max());
+    uniform_int_distribution<int> positiveRange(0, 1000000000);
+
+    switch (shape) {
+    case SORTED:
+    case REVERSE_SORTED:
+    case NEARLY_SORTED: {
+        for (int i = 0; i < size; i++) {
+            result[i] = positiveRange(generator);
+        }
+        sort(result.begin(), result.end());
+        if (shape == REVERSE_SORTED) {
+            reverse(result.begin(), result.end());
+        }
+        if (shape == NEARLY_SORTED && size > 1) {
+            int swaps = parameters.swaps > 0 ? parameters.swaps : max(1, size / 100);
+            uniform_int_distribution<int> position(0, size - 1);
+            for (int s = 0; s < swaps; s++) {
+                swap(result[position(generator)], result[position(generator)]);
+            }
+        }
+        break;
+    }
+    case ORGAN_PIPE: {
+        // Ascending to the middle, then descending
+        int step = rampStep((size - 1) / 2);
+        for (int i = 0; i < size; i++) {
+            result[i] = min(i, size - 1 - i) * step;
+        }
+        break;
+    }
+    case SAWTOOTH: {
+        int teeth = parameters.teeth > 0 ? parameters.teeth : 16;
+        int toothLength = max(1, size / teeth);
+        int step = rampStep(toothLength - 1);
+        for (int i = 0; i < size; i++) {
+            result[i] = (i % toothLength) * step;
+        }
+        break;
+    }
+    case ZIPF: {
+        // Rank k is drawn with probability proportional to 1 / k^s
+        double exponent = parameters.zipfExponent > 0 ? parameters.zipfExponent : 1.1;
+        // The table of cumulative weights is capped so huge arrays stay cheap
+        int ranks = parameters.zipfRanks > 0 ? parameters.zipfRanks : max(1, min(size, 1000000));
+        vector<double> cumulative(ranks);
+        double total = 0;
+        for (int k = 0; k < ranks; k++) {
+            total += 1.0 / pow(k + 1.0, exponent);
+            cumulative[k] = total;
+        }
+        uniform_real_distribution<double> probability(0.0, total);
+        for (int i = 0; i < size; i++) {
+            result[i] = static_cast<int>(lower_bound(cumulative.begin(), cumulative.end(),
+                probability(generator)) - cumulative.begin());
+            result[i] = min(result[i], ranks - 1);
+        }
+        break;
+    }
+    case ALL_EQUAL: {
+        fill(result.begin(), result.end(), positiveRange(generator));
+        break;
+    }
+    case FEW_DISTINCT_WIDE: {
+        int distinctCount = parameters.distinctValues > 0 ? parameters.distinctValues : 16;
+        vector<int> distinctValues(distinctCount);
+        for (int& value : distinctValues) {
+            value = fullRange(generator);
+        }
+        uniform_int_distribution<int> pick(0, distinctCount - 1);
+        for (int i = 0; i < size; i++) {
+            result[i] = distinctValues[pick(generator)];
+        }
+        break;
+    }
+    case NEGATIVE_HEAVY: {
+        // 90% of keys are negative
+        uniform_int_distribution<int> negativeRange(-1000000000, -1);
+        uniform_int_distribution<int> percent(0, 99);
+        for (int i = 0; i < size; i++) {
+            result[i] = percent(generator) < 90 ? negativeRange(generator) : positiveRange(generator);
+        }
+        break;
+    }
+    case CLUSTERED: {
+        // Tight normal clusters around centers spread over the full range
+        int clusterCount = parameters.clusters > 0 ? parameters.clusters : 8;
+        vector<double> centers(clusterCount);
+        for (double& center : centers) {
+            center = fullRange(generator);
+        }
+        uniform_int_distribution<int> pick(0, clusterCount - 1);
+        normal_distribution<double> spread(0.0, 1000.0);
+        for (int i = 0; i < size; i++) {
+            double value = centers[pick(generator)] + spread(generator);
+            value = max<double>(numeric_limits<int>::min(), min<double>(numeric_limits<int>::max(), value));
+            result[i] = static_cast<int>(value);
+        }
+        break;
+    }
+    }
+    return result;
+}
+
+// ============================================================================
+// BINARY DATASET CACHE
+// ============================================================================
+// Stores each generated dataset as a raw binary file and maps it back with
+// mmap on later runs, so large experiments start at page-cache speed and
+// reuse identical inputs. Shape arrays are keyed by (shape, size, parameters,
+// seed); other record arrays (points, edges, byte keys) by a dataset name
+// that spells out the generator's parameters and seed, plus its version.
+// File layout: 8-byte magic, 8-byte record count, 8-byte record size, then
+// the records. File names carry the generator version, and the magic carries
+// the layout version. Without POSIX mmap the file is read with a plain stream.
+// The experiment harness takes every generated dataset from
+// harnessDatasetCache(); only the small fixed-seed generate*Array inputs are
+// regenerated, since producing them costs less than a file open.
+const uint64_t DATASET_CACHE_MAGIC = 0x3243534154414453ULL; // "SDATASC2"
+const int RECORD_GENERATOR_VERSION = 1;
+const size_t DATASET_HEADER_BYTES = 3 * sizeof(uint64_t);
+
+// Copy-on-write view of a cached dataset file; unmapped on destruction. The
+// mapping is private and writable, so a caller can sort the records in place
+// without first copying them out: only the pages it writes are duplicated.
+class MappedDataset {
+public:
+    explicit MappedDataset(const string& path, size_t recordBytes = sizeof(int)) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size >= static_cast<off_t>(DATASET_HEADER_BYTES)) {
+            void* mapping = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+                mappedBytes = fileStat.st_size;
+                mappedData = mapping;
+            }
+        }
+        close(fd);
+        if (mappedData == nullptr) return;
+        const uint64_t* header = static_cast<const uint64_t*>(mappedData);
+        if (header[0] == DATASET_CACHE_MAGIC && header[2] == recordBytes &&
+            (mappedBytes - DATASET_HEADER_BYTES) / recordBytes == header[1] &&
+            (mappedBytes - DATASET_HEADER_BYTES) % recordBytes == 0) {
+            payload = static_cast<char*>(mappedData) + DATASET_HEADER_BYTES;
+            recordCount = header[1];
+        }
+#else
+        ifstream input(path, ios::binary);
+        uint64_t header[3] = { 0, 0, 0 };
+        if (!input.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != DATASET_CACHE_MAGIC ||
+            header[2] != recordBytes) {
+            return;
+        }
+        fallbackBytes.resize(max<size_t>(1, header[1] * recordBytes));
+        if (!input.read(fallbackBytes.data(), header[1] * recordBytes)) return;
+        payload = fallbackBytes.data();
+        recordCount = header[1];
+#endif
+    }
+
+    ~MappedDataset() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mappedData != nullptr) munmap(mappedData, mappedBytes);
+#endif
+    }
+
+    MappedDataset(const MappedDataset&) = delete;
+    MappedDataset& operator=(const MappedDataset&) = delete;
+
+    bool valid() const { return payload != nullptr; }
+    size_t size() const { return recordCount; }
+    int* data() { return records<int>(); }
+    const int* data() const { return static_cast<const int*>(payload); }
+
+    template<typename Record>
+    Record* records() { return static_cast<Record*>(payload); }
+
+private:
+    void* mappedData = nullptr;
+    size_t mappedBytes = 0;
+    void* payload = nullptr;
+    size_t recordCount = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+    vector<char> fallbackBytes;
+#endif
+};
+
+class DatasetCache {
+public:
+    explicit DatasetCache(const string& cacheDirectory = "dataset_cache") : directory(cacheDirectory) {
+#if defined(__unix__) || defined(__APPLE__)
+        mkdir(directory.c_str(), 0755);
+#endif
+    }
+
+    // Cached shape array; generated and stored on a miss. A hit costs one
+    // copy out of the page cache into the returned vector.
+    vector<int> load(InputShape shape, int size, unsigned seed,
+        const ShapeParameters& parameters = ShapeParameters()) {
+        string path = pathFor(shape, size, seed, parameters);
+        {
+            MappedDataset mapped(path);
+            if (mapped.valid() && mapped.size() == static_cast<size_t>(size)) {
+                lastLoadWasHit = true;
+                return vector<int>(mapped.data(), mapped.data() + mapped.size());
+            }
+        }
+
+        lastLoadWasHit = false;
+        vector<int> generated = generateShapeArray(shape, size, seed, parameters);
+        store(path, generated);
+        return generated;
+    }
+
+    // Zero-copy variant: the cached file's copy-on-write mapping itself,
+    // generated and stored first on a miss. Null if the file cannot be mapped.
+    unique_ptr<MappedDataset> map(InputShape shape, int size, unsigned seed,
+        const ShapeParameters& parameters = ShapeParameters()) {
+        string path = pathFor(shape, size, seed, parameters);
+        unique_ptr<MappedDataset> mapped(new MappedDataset(path));
+        lastLoadWasHit = mapped->valid() && mapped->size() == static_cast<size_t>(size);
+        if (lastLoadWasHit) return mapped;
+
+        store(path, generateShapeArray(shape, size, seed, parameters));
+        mapped.reset(new MappedDataset(path));
+        if (!mapped->valid() || mapped->size() != static_cast<size_t>(size)) mapped.reset();
+        return mapped;
+    }
+
+    // Cached array of plain records (no pointers) from any other generator.
+    // datasetName must identify the generator, its parameters and its seed;
+    // bump RECORD_GENERATOR_VERSION whenever one of those generators changes.
+    template<typename Record, typename Generator>
+    vector<Record> loadOrGenerate(const string& datasetName, Generator generate) {
+        ostringstream name;
+        name << directory << "/r" << RECORD_GENERATOR_VERSION << "_" << datasetName << ".bin";
+        {
+            MappedDataset mapped(name.str(), sizeof(Record));
+            if (mapped.valid()) {
+                lastLoadWasHit = true;
+                const Record* records = mapped.records<Record>();
+                return vector<Record>(records, records + mapped.size());
+            }
+        }
+
+        lastLoadWasHit = false;
+        vector<Record> generated = generate();
+        storeRecords(name.str(), generated.data(), generated.size(), sizeof(Record));
+        return generated;
+    }
+
+    // Same, but copies the keys straight into caller-owned memory (for example
+    // a shared segment) without an intermediate vector on a hit
+    void loadInto(InputShape shape, int size, unsigned seed, int* destination,
+        const ShapeParameters& parameters = ShapeParameters()) {
+        string path = pathFor(shape, size, seed, parameters);
+        {
+            MappedDataset mapped(path);
+            if (mapped.valid() && mapped.size() == static_cast<size_t>(size)) {
+                lastLoadWasHit = true;
+                copy(mapped.data(), mapped.data() + mapped.size(), destination);
+                return;
+            }
+        }
+
+        lastLoadWasHit = false;
+        vector<int> generated = generateShapeArray(shape, size, seed, parameters);
+        store(path, generated);
+        copy(generated.begin(), generated.end(), destination);
+    }
+
+    bool lastWasHit() const { return lastLoadWasHit; }
+
+    string pathFor(InputShape shape, int size, unsigned seed, const ShapeParameters& parameters) const {
+        ostringstream name;
+        name << directory << "/g" << SHAPE_GENERATOR_VERSION << "_shape" << static_cast<int>(shape) << "_n" << size
+            << "_k" << parameters.swaps << "_z" << parameters.zipfExponent << "_r" << parameters.zipfRanks
+            << "_d" << parameters.distinctValues << "_t" << parameters.teeth
+            << "_c" << parameters.clusters << "_s" << seed << ".bin";
+        return name.str();
+    }
+
+private:
+    void store(const string& path, const vector<int>& keys) const {
+        storeRecords(path, keys.data(), keys.size(), sizeof(int));
+    }
+
+    // Write to a temporary name and rename, so readers never see partial files;
+    // the name is per process because forked experiment clients share the cache
+    void storeRecords(const string& path, const void* records, size_t recordCount, size_t recordBytes) const {
+#if defined(__unix__) || defined(__APPLE__)
+        string temporaryPath = path + ".tmp" + to_string(getpid());
+#else
+        string temporaryPath = path + ".tmp";
+#endif
+        {
+            ofstream output(temporaryPath, ios::binary | ios::trunc);
+            if (!output) return;
+            uint64_t header[3] = { DATASET_CACHE_MAGIC, recordCount, recordBytes };
+            output.write(reinterpret_cast<const char*>(header), sizeof(header));
+            output.write(static_cast<const char*>(records), recordCount * recordBytes);
+            if (!output) return;
+        }
+        rename(temporaryPath.c_str(), path.c_str());
+    }
+
+    string directory;
+    bool lastLoadWasHit = false;
+};
+
+// Cache shared by every experiment in the harness
+DatasetCache& harnessDatasetCache() {
+    static DatasetCache cache;
+    return cache;
+}
+
+// ============================================================================
+// SORT ENGINE REGISTRY
+// ============================================================================
+// Bytes of key traffic an engine must move at minimum on this input. Passes
+// that stream are bounded by copy bandwidth; scatter passes whose fan-out is
+// too wide to stay sequential are bounded by random-scatter bandwidth.
+// streamedBytes is negative when the engine has no pass-based traffic model.
+struct TrafficEstimate {
+    double streamedBytes;
+    double scatteredBytes;
+};
+
+typedef function<TrafficEstimate(const vector<int>&)> TrafficModel;
+
+// Widest scatter fan-out still treated as sequential write streams. A few
+// hundred streams fit the write-combining buffers and TLB; a 2^11 or 2^16
+// digit radix, or a counting scatter over the key range, does not. A scatter
+// whose destination fits in cache never reaches DRAM at random, so it counts
+// as streamed whatever its fan-out.
+const double SEQUENTIAL_SCATTER_FAN_OUT = 512;
+const double CACHE_RESIDENT_SCATTER_BYTES = 1 << 20;
+
+// Traffic of a sort over n keys whose scatter passes (scatterBytes) each write
+// n keys to fanOut targets
+TrafficEstimate passTraffic(size_t n, double streamedBytes, double scatterBytes, double fanOut) {
+    if (fanOut <= SEQUENTIAL_SCATTER_FAN_OUT || n * sizeof(int) <= CACHE_RESIDENT_SCATTER_BYTES) {
+        return { streamedBytes + scatterBytes, 0.0 };
+    }
+    return { streamedBytes, scatterBytes };
+}
+
+// Number of distinct key slots (max - min + 1) a counting scatter spans
+double keyRangeOf(const vector<int>& array) {
+    if (array.empty()) return 0;
+    auto extremes = minmax_element(array.begin(), array.end());
+    return static_cast<double>(*extremes.second) - *extremes.first + 1;
+}
+
+// Every vector<int> engine with the input limits it can handle, so shape
+// sweeps can run each engine on each input and skip the ones out of range.
+struct SortEngine {
+    string name;
+    function<void(vector<int>&)> sort;
+    long long maxRange;      // largest (max - min + 1) the engine accepts, 0 = any
+    bool needsNonNegative;   // engine only handles keys >= 0
+    TrafficModel minimumTraffic;
+};
+
+// Number of decimal digit passes radixSortLSD runs for this input
+int decimalPassCount(const vector<int>& array) {
+    if (array.empty()) return 0;
+    long long maxValue = *max_element(array.begin(), array.end());
+    int passes = 0;
+    for (long long digitPosition = 1; maxValue / digitPosition > 0; digitPosition *= 10) {
+        passes++;
+    }
+    return passes;
+}
+
+// Number of digit passes a digitBits-wide radix runs (digits where keys differ)
+int digitPassCount(const vector<int>& array, int digitBits) {
+    if (array.empty()) return 0;
+    uint32_t allOnes = radixKeyOf(array.front());
+    uint32_t allZeros = allOnes;
+    for (int value : array) {
+        allOnes &= radixKeyOf(value);
+        allZeros |= radixKeyOf(value);
+    }
+    int passes = 0;
+    for (int shift = 0; shift < 32; shift += digitBits) {
+        if (((allOnes ^ allZeros) >> shift) & ((1u << digitBits) - 1)) passes++;
+    }
+    return passes;
+}
+
+vector<SortEngine> sortEngines() {
+    const long long COUNTING_RANGE_LIMIT = 1LL << 24;
+    const long long PIGEONHOLE_RANGE_LIMIT = 1LL << 20;
+    const long long INT_RANGE_LIMIT = numeric_limits<int>::max();
+    int threadCount = max(1, static_cast<int>(thread::hardware_concurrency()));
+    auto signedKey = [](int value) { return radixKeyOf(value); };
+
+    // Traffic models: a histogram pass reads n keys, a scatter pass reads and
+    // writes n keys, e.g. byte radix = 1 read + p x (read + write). The scatter
+    // fan-out decides which bandwidth bounds the scatter passes.
+    const double KEY = sizeof(int);
+    TrafficModel noModel = [](const vector<int>&) { return TrafficEstimate{ -1.0, 0.0 }; };
+    TrafficModel countingStableTraffic = [=](const vector<int>& array) {
+        return passTraffic(array.size(), KEY * array.size(), 2 * KEY * array.size(), keyRangeOf(array));
+    };
+    TrafficModel countingTraffic = [=](const vector<int>& array) {
+        return passTraffic(array.size(), 2 * KEY * array.size(), 0.0, 1);
+    };
+    TrafficModel decimalRadixTraffic = [=](const vector<int>& array) {
+        double passes = decimalPassCount(array);
+        return passTraffic(array.size(), KEY * array.size() * passes, 2 * KEY * array.size() * passes, 10);
+    };
+    TrafficModel learnedBucketTraffic = [=](const vector<int>& array) {
+        double bucketCount = max<size_t>(1, array.size() / tuningProfile().learnedBucketLoadFactor);
+        return passTraffic(array.size(), KEY * array.size(), 2 * KEY * array.size(), bucketCount);
+    };
+    TrafficModel byteRadixTraffic = [=](const vector<int>& array) {
+        return passTraffic(array.size(), KEY * array.size(), 2 * KEY * array.size() * digitPassCount(array, 8), 256);
+    };
+    TrafficModel tunedRadixTraffic = [=](const vector<int>& array) {
+        int digitBits = tuningProfile().radixDigitBits;
+        return passTraffic(array.size(), KEY * array.size(), 2 * KEY * array.size() * digitPassCount(array, digitBits),
+            static_cast<double>(1u << digitBits));
+    };
+
+    vector<SortEngine> engines;
+    engines.push_back({ "Counting Sort (Stable)", countingSortStable, COUNTING_RANGE_LIMIT, false, countingStableTraffic });
+    engines.push_back({ "Counting Sort (Non-Stable)", countingSortNonStable, COUNTING_RANGE_LIMIT, false, countingTraffic });
+    engines.push_back({ "Radix Sort (LSD)", radixSortLSD, 0, true, decimalRadixTraffic });
+    engines.push_back({ "Pigeonhole Sort", pigeonholeSort, PIGEONHOLE_RANGE_LIMIT, false, countingStableTraffic });
+    engines.push_back({ "Bucket Sort", bucketSort, INT_RANGE_LIMIT, false, noModel });
+    engines.push_back({ "Bucket Sort (Learned CDF)", bucketSortLearnedCDF, 0, false, learnedBucketTraffic });
+    engines.push_back({ "Byte Radix (LSD)", [=](vector<int>& array) { radixSortByteLSD(array, signedKey); }, 0, false,
+        tunedRadixTraffic });
+    engines.push_back({ "Stable In-Place Radix", [=](vector<int>& array) { stableRadixSortInPlace(array, signedKey); }, 0, false,
+        byteRadixTraffic });
+    engines.push_back({ "Parallel In-Place Radix", [=](vector<int>& array) {
+        parallelRadixSortInPlace(array, signedKey, threadCount);
+    }, 0, false, byteRadixTraffic });
+    engines.push_back({ "Parallel Merge Sort", [=](vector<int>& array) {
+        parallelStableMergeSort(array, threadCount);
+    }, 0, false, noModel });
+    engines.push_back({ "std::sort", [](vector<int>& array) { std::sort(array.begin(), array.end()); }, 0, false, noModel });
+    return engines;
+}
+
+// Whether the engine's range and sign limits admit this input
+bool engineSupports(const SortEngine& engine, const vector<int>& array) {
+    if (array.empty()) return true;
+    long long minValue = *min_element(array.begin(), array.end());
+    long long maxValue = *max_element(array.begin(), array.end());
+    if (engine.needsNonNegative && minValue < 0) return false;
+    return engine.maxRange == 0 || maxValue - minValue + 1 <= engine.maxRange;
+}
+
+// ============================================================================
+// MACHINE ROOFLINE CALIBRATION
+// ============================================================================
+// Measures this machine's achievable bandwidth for the access patterns the
+// engines use, on a buffer well beyond the last-level cache. Each figure is
+// the best of several runs and counts every byte read plus every byte
+// written. A sort's efficiency is then its model minimum time (streamed bytes
+// / copy bandwidth + wide-scatter bytes / scatter bandwidth) as a percentage
+// of its measured time.
+struct MachineBandwidth {
+    double readGBs;
+    double writeGBs;
+    double copyGBs;
+    double scatterGBs;
+};
+
+MachineBandwidth calibrateMachineBandwidth(size_t bufferBytes = 64 * 1024 * 1024) {
+    const int REPETITIONS = 3;
+    size_t n = bufferBytes / sizeof(int);
+    vector<int> source(n, 1);
+    vector<int> target(n, 0);
+    vector<uint32_t> scatterIndex(n);
+    for (size_t i = 0; i < n; i++) {
+        scatterIndex[i] = static_cast<uint32_t>(i);
+    }
+    shuffle(scatterIndex.begin(), scatterIndex.end(), mt19937(89));
+    volatile long long sink = 0;
+
+    auto bestGBs = [&](double bytesMoved, function<void()> kernel) {
+        double bestSeconds = 1e30;
+        for (int r = 0; r < REPETITIONS; r++) {
+            auto startTime = high_resolution_clock::now();
+            kernel();
+            duration<double> elapsed = high_resolution_clock::now() - startTime;
+            bestSeconds = min(bestSeconds, elapsed.count());
+        }
+        return bytesMoved / bestSeconds / 1e9;
+    };
+
+    MachineBandwidth bandwidth;
+    bandwidth.readGBs = bestGBs(static_cast<double>(n) * sizeof(int), [&]() {
+        long long sum = 0;
+        for (size_t i = 0; i < n; i++) sum += source[i];
+        sink += sum;
+    });
+    bandwidth.writeGBs = bestGBs(static_cast<double>(n) * sizeof(int), [&]() {
+        fill(target.begin(), target.end(), static_cast<int>(sink & 1));
+    });
+    bandwidth.copyGBs = bestGBs(2.0 * n * sizeof(int), [&]() {
+        copy(source.begin(), source.end(), target.begin());
+        sink += target[n / 2];
+    });
+    bandwidth.scatterGBs = bestGBs(static_cast<double>(n) * (2 * sizeof(int) + sizeof(uint32_t)), [&]() {
+        for (size_t i = 0; i < n; i++) target[scatterIndex[i]] = source[i];
+        sink += target[n / 2];
+    });
+    return bandwidth;
+}
+
+// Model minimum time as a percentage of the measured time (negative = no model)
+double rooflineEfficiency(const TrafficEstimate& traffic, double measuredMs, const MachineBandwidth& bandwidth) {
+    if (traffic.streamedBytes < 0 || measuredMs <= 0) return -1.0;
+    double minimumMs = (traffic.streamedBytes / (bandwidth.copyGBs * 1e9) +
+        traffic.scatteredBytes / (bandwidth.scatterGBs * 1e9)) * 1000.0;
+    return 100.0 * minimumMs / measuredMs;
+}
+
+// ============================================================================
+// EXPERIMENTAL TEST SUITE
+// ============================================================================
+
+// Fixed-size record used to find the indirect vs direct sorting crossover
+template<size_t RECORD_BYTES>
+struct BenchmarkRecord {
+    int key;
+    char payload[RECORD_BYTES - sizeof(int)];
+};
+
+// Time direct key-value radix sorting against both indirect sort variants
+template<size_t RECORD_BYTES>
+void runIndirectSortBenchmark(int recordCount) {
+    typedef BenchmarkRecord<RECORD_BYTES> Record;
+
+    vector<int> keys = generateLargeRangeFewRepeats(recordCount);
+    vector<Record> records(recordCount);
+    for (int i = 0; i < recordCount; i++) {
+        records[i].key = keys[i];
+        fill(begin(records[i].payload), end(records[i].payload), static_cast<char>(i));
+    }
+
+    auto keyOf = [](const Record& record) { return record.key; };
+    auto isSortedByKey = [](const vector<Record>& sortedRecords) {
+        for (size_t i = 1; i < sortedRecords.size(); i++) {
+            if (sortedRecords[i].key < sortedRecords[i - 1].key) return false;
+        }
+        return true;
+    };
+
+    cout << "Record Size: " << RECORD_BYTES << " bytes, Count: " << recordCount << endl;
+
+    vector<Record> direct = records;
+    auto directStart = high_resolution_clock::now();
+    radixSortByteLSD(direct, [](const Record& record) { return radixKeyOf(record.key); });
+    duration<double, milli> directTime = high_resolution_clock::now() - directStart;
+
+    vector<Record> gathered = records;
+    auto gatherStart = high_resolution_clock::now();
+    indirectSort(gathered, keyOf);
+    duration<double, milli> gatherTime = high_resolution_clock::now() - gatherStart;
+
+    vector<Record> cycled = records;
+    auto cycleStart = high_resolution_clock::now();
+    indirectSort(cycled, keyOf, true);
+    duration<double, milli> cycleTime = high_resolution_clock::now() - cycleStart;
+
+    if (!isSortedByKey(direct) || !isSortedByKey(gathered) || !isSortedByKey(cycled)) {
+        cout << "ERROR: Record sort did not sort correctly!" << endl;
+    }
+    cout << "  Direct Key-Value Radix:    " << fixed << setprecision(3) << directTime.count() << " ms" << endl;
+    cout << "  Indirect (Gather):         " << fixed << setprecision(3) << gatherTime.count() << " ms" << endl;
+    cout << "  Indirect (In-Place):       " << fixed << setprecision(3) << cycleTime.count() << " ms" << endl;
+    cout << endl;
+}
+
+// A UUID with the row it came from, as the dedup pipelines carry it
+struct UuidRow {
+    Uuid key;
+    uint32_t row;
+
+    bool operator==(const UuidRow& other) const { return key == other.key && row == other.row; }
+};
+
+template<size_t KEY_BYTES>
+FixedWidthKey<KEY_BYTES> randomFixedWidthKey(mt19937& generator) {
+    FixedWidthKey<KEY_BYTES> key;
+    for (size_t b = 0; b < KEY_BYTES; b++) {
+        key.bytes[b] = static_cast<uint8_t>(generator());
+    }
+    return key;
+}
+
+// Time std::sort against the wide-key MSD radix sort; the radix result must
+// match std::stable_sort exactly, payload included
+template<typename Record, typename Less, typename RadixSort>
+void runWideKeyBenchmark(const string& label, const vector<Record>& records, Less less, RadixSort radixSort) {
+    cout << label << " (Count: " << records.size() << ")" << endl;
+
+    vector<Record> compared = records;
+    auto compareStart = high_resolution_clock::now();
+    sort(compared.begin(), compared.end(), less);
+    duration<double, milli> compareTime = high_resolution_clock::now() - compareStart;
+
+    vector<Record> radixSorted = records;
+    auto radixStart = high_resolution_clock::now();
+    radixSort(radixSorted);
+    duration<double, milli> radixTime = high_resolution_clock::now() - radixStart;
+
+    vector<Record> expected = records;
+    stable_sort(expected.begin(), expected.end(), less);
+    if (!(radixSorted == expected)) {
+        cout << "ERROR: Wide-key radix sort differs from std::stable_sort!" << endl;
+    }
+    cout << "  std::sort:                 " << fixed << setprecision(3) << compareTime.count() << " ms" << endl;
+    cout << "  Wide MSD Radix:            " << fixed << setprecision(3) << radixTime.count() << " ms" << endl;
+    cout << endl;
+}
+
+// Coordinates live in an array so code can index them by dimension
+struct PointRecord2D {
+    float coords[2];   // x, y
+    uint32_t id;
+};
+
+struct PointRecord3D {
+    float coords[3];   // x, y, z
+    uint32_t id;
+};
+
+// Point cloud of Gaussian clusters inside [0, 1000]^3, seeded
+template<typename Point>
+vector<Point> generatePointCloud(size_t count, unsigned seed, int dimensions) {
+    mt19937 generator(seed);
+    uniform_real_distribution<float> centre(100.0f, 900.0f);
+    normal_distribution<float> spread(0.0f, 25.0f);
+    vector<float> centres(64 * 3);
+    for (float& coordinate : centres) coordinate = centre(generator);
+    vector<Point> points(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t cluster = generator() % 64;
+        for (int d = 0; d < dimensions; d++) {
+            points[i].coords[d] = max(0.0f, min(1000.0f, centres[cluster * 3 + d] + spread(generator)));
+        }
+        points[i].id = static_cast<uint32_t>(i);
+    }
+    return points;
+}
+
+// Mean distance between consecutive points: lower means better locality
+template<typename Point>
+double meanStepLength(const vector<Point>& points, int dimensions) {
+    double total = 0;
+    for (size_t i = 1; i < points.size(); i++) {
+        double squared = 0;
+        for (int d = 0; d < dimensions; d++) {
+            double delta = static_cast<double>(points[i].coords[d]) - points[i - 1].coords[d];
+            squared += delta * delta;
+        }
+        total += sqrt(squared);
+    }
+    return points.size() > 1 ? total / (points.size() - 1) : 0.0;
+}
+
+// Time sortByCurveCode against std::sort on the same (code, index) pairs;
+// both times include computing the codes and gathering the points
+template<typename Point, typename CodeFunction>
+void runCurveSortBenchmark(const string& label, const vector<Point>& points, int dimensions, CodeFunction codeOf) {
+    cout << label << " (Points: " << points.size() << ")" << endl;
+
+    vector<Point> radixSorted = points;
+    auto radixStart = high_resolution_clock::now();
+    sortByCurveCode(radixSorted, codeOf);
+    duration<double, milli> radixTime = high_resolution_clock::now() - radixStart;
+
+    vector<Point> comparisonSorted = points;
+    auto comparisonStart = high_resolution_clock::now();
+    vector<CurveCodeIndex> pairs(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        pairs[i].code = codeOf(points[i]);
+        pairs[i].index = static_cast<uint32_t>(i);
+    }
+    sort(pairs.begin(), pairs.end(), [](const CurveCodeIndex& a, const CurveCodeIndex& b) {
+        return a.code != b.code ? a.code < b.code : a.index < b.index;
+    });
+    vector<uint32_t> sourceIndex(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) sourceIndex[i] = pairs[i].index;
+    applyPermutation(comparisonSorted, sourceIndex);
+    duration<double, milli> comparisonTime = high_resolution_clock::now() - comparisonStart;
+
+    for (size_t i = 0; i < points.size(); i++) {
+        if (radixSorted[i].id != comparisonSorted[i].id) {
+            cout << "ERROR: " << label << " curve sort differs from std::sort!" << endl;
+            break;
+        }
+    }
+    cout << "  Radix Sort + Gather:       " << fixed << setprecision(3) << radixTime.count() << " ms" << endl;
+    cout << "  std::sort + Gather:        " << fixed << setprecision(3) << comparisonTime.count() << " ms" << endl;
+    cout << "  Mean Step Length:          " << fixed << setprecision(3) << meanStepLength(points, dimensions)
+        << " unsorted -> " << meanStepLength(radixSorted, dimensions) << " sorted" << endl;
+    cout << endl;
+}
+
+// Times std::sort, the range-scanning counting sort (on a widened int copy)
+// and the full-domain counting sort on 8/16-bit keys, against a memset of
+// the same bytes as the speed-of-light reference.
+template<typename Small>
+void runSmallKeyBenchmark(const string& label, vector<Small> keys) {
+    cout << label << ": " << keys.size() << " keys (" << fixed << setprecision(1)
+        << keys.size() * sizeof(Small) / (1024.0 * 1024.0) << " MB)" << endl;
+
+    vector<Small> expected = keys;
+    auto stdStart = high_resolution_clock::now();
+    sort(expected.begin(), expected.end());
+    duration<double, milli> stdTime = high_resolution_clock::now() - stdStart;
+
+    vector<int> widened(keys.begin(), keys.end());
+    auto rangeStart = high_resolution_clock::now();
+    countingSortNonStable(widened);
+    duration<double, milli> rangeTime = high_resolution_clock::now() - rangeStart;
+
+    vector<Small> fullDomain = keys;
+    auto fullStart = high_resolution_clock::now();
+    countingSortFullDomain(fullDomain);
+    duration<double, milli> fullTime = high_resolution_clock::now() - fullStart;
+    if (fullDomain != expected) cout << "ERROR: " << label << " full-domain counting sort is not sorted!" << endl;
+
+    auto fillStart = high_resolution_clock::now();
+    memset(keys.data(), 0, keys.size() * sizeof(Small));
+    duration<double, milli> fillTime = high_resolution_clock::now() - fillStart;
+
+    cout << "  std::sort:                 " << fixed << setprecision(3) << stdTime.count() << " ms" << endl;
+    cout << "  countingSortNonStable:     " << rangeTime.count() << " ms (widened to int)" << endl;
+    cout << "  countingSortFullDomain:    " << fullTime.count() << " ms" << endl;
+    cout << "  memset (reference):        " << fillTime.count() << " ms" << endl;
+}
+
+void runExperimentalTests() {
+    cout << "\n============================================" << endl;
+    cout << "   EXPERIMENTAL TEST CASES" << endl;
+    cout << "============================================\n" << endl;
+
+    // Machine roofline: achievable bandwidth for the engines' access patterns
+    MachineBandwidth bandwidth = calibrateMachineBandwidth();
+    cout << "MACHINE BANDWIDTH (64 MB buffer, best of 3)" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "  Sequential Read:           " << fixed << setprecision(2) << bandwidth.readGBs << " GB/s" << endl;
+    cout << "  Sequential Write:          " << fixed << setprecision(2) << bandwidth.writeGBs << " GB/s" << endl;
+    cout << "  Copy (read + write):       " << fixed << setprecision(2) << bandwidth.copyGBs << " GB/s" << endl;
+    cout << "  Random Scatter:            " << fixed << setprecision(2) << bandwidth.scatterGBs << " GB/s" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 1: VARYING INPUT RANGE SIZE
+    // ========================================================================
+    cout << "TEST 1: VARYING INPUT RANGE SIZE" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Evaluate performance with different value ranges" << endl;
+    cout << "Expected: Counting sort struggles with large ranges" << endl;
+    cout << "         Radix/Bucket sort relatively unaffected\n" << endl;
+
+    vector<int> rangeSizes = { 100, 1000, 10000, 100000 };
+    int fixedSize = 1000;
+
+    for (int range : rangeSizes) {
+        cout << "Range [0, " << range << "], Size: " << fixedSize << endl;
+        vector<int> testData = generateVaryingRangeArray(fixedSize, range);
+
+        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
+        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+        cout << "  Bucket Sort:               " << fixed << setprecision(3)
+            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 2: DIFFERENT DATA DISTRIBUTIONS
+    // ========================================================================
+    cout << "\nTEST 2: DIFFERENT DATA DISTRIBUTIONS" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Test algorithms on uniform, normal, and skewed data" << endl;
+    cout << "Expected: Bucket sort performs best on uniform distribution" << endl;
+    cout << "         Others less affected by distribution\n" << endl;
+
+    int distributionTestSize = 5000;
+    vector<string> distributionNames = { "Uniform", "Normal", "Skewed", "Exponential" };
+    vector<Distribution> distributions = { UNIFORM, NORMAL, SKEWED, EXPONENTIAL };
+
+    for (size_t i = 0; i < distributions.size(); i++) {
+        cout << distributionNames[i] << " Distribution (Size: " << distributionTestSize << ")" << endl;
+        vector<int> testData = generateDistributionArray(distributionTestSize, distributions[i]);
+
+        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
+        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+        cout << "  Bucket Sort:               " << fixed << setprecision(3)
+            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
+        cout << "  Bucket Sort (Learned CDF): " << fixed << setprecision(3)
+            << measureSortingTime(testData, bucketSortLearnedCDF, "Bucket Sort Learned CDF") << " ms" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 3: VARYING INPUT SIZE (SCALABILITY TEST)
+    // ========================================================================
+    cout << "\nTEST 3: VARYING INPUT SIZE (SCALABILITY TEST)" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Evaluate how algorithms scale with input size" << endl;
+    cout << "Expected: Linear growth for counting/radix/pigeonhole" << endl;
+    cout << "         Potential quadratic for bucket sort in worst case\n" << endl;
+
+    vector<int> inputSizes = { 1000, 5000, 10000, 20000 };
+    int mergeSortThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+    for (int size : inputSizes) {
+        cout << "Input Size: " << size << endl;
+        vector<int> testData = generateScalabilityArray(size);
+
+        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
+        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+        cout << "  Bucket Sort:               " << fixed << setprecision(3)
+            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
+        cout << "  std::stable_sort:          " << fixed << setprecision(3)
+            << measureSortingTime(testData, [](vector<int>& array) { stable_sort(array.begin(), array.end()); },
+                "std::stable_sort") << " ms" << endl;
+        cout << "  Parallel Merge Sort:       " << fixed << setprecision(3)
+            << measureSortingTime(testData, [&](vector<int>& array) { parallelStableMergeSort(array, mergeSortThreads); },
+                "Parallel Merge Sort") << " ms" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 4: WORST CASE FOR BUCKET SORT
+    // ========================================================================
+    cout << "\nTEST 4: WORST CASE FOR BUCKET SORT" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Test bucket sort with poor distribution (all in few buckets)" << endl;
+    cout << "Expected: Bucket sort degrades to O(n) due to uneven distribution" << endl;
+    cout << "         Other algorithms unaffected\n" << endl;
+
+    int worstCaseSize = 5000;
+    cout << "Small Range [0, 10], Size: " << worstCaseSize << " (Worst Case)" << endl;
+    vector<int> worstCaseData = generateWorstCaseBucketSort(worstCaseSize);
+
+    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+        << measureSortingTime(worstCaseData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+        << measureSortingTime(worstCaseData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+        << measureSortingTime(worstCaseData, radixSortLSD, "Radix Sort") << " ms" << endl;
+    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+        << measureSortingTime(worstCaseData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+    cout << "  Bucket Sort:               " << fixed << setprecision(3)
+        << measureSortingTime(worstCaseData, bucketSort, "Bucket Sort") << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 5: LARGE RANGE WITH FEW REPEATED VALUES
+    // ========================================================================
+    cout << "\nTEST 5: LARGE RANGE WITH FEW REPEATED VALUES" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Test with sparse data over large range" << endl;
+    cout << "Expected: Counting/Pigeonhole sort inefficient (memory)" << endl;
+    cout << "         Radix/Bucket sort more efficient\n" << endl;
+
+    int largeRangeSize = 5000;
+    cout << "Range [0, 1000000], Size: " << largeRangeSize << endl;
+    vector<int> largeRangeData = generateLargeRangeFewRepeats(largeRangeSize);
+
+    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+        << measureSortingTime(largeRangeData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+        << measureSortingTime(largeRangeData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+        << measureSortingTime(largeRangeData, radixSortLSD, "Radix Sort") << " ms" << endl;
+    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+        << measureSortingTime(largeRangeData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+    cout << "  Bucket Sort:               " << fixed << setprecision(3)
+        << measureSortingTime(largeRangeData, bucketSort, "Bucket Sort") << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 6: MANY DUPLICATE VALUES
+    // ========================================================================
+    cout << "\nTEST 6: MANY DUPLICATE VALUES" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Test with high duplicate rate" << endl;
+    cout << "Expected: Counting/Pigeonhole excel with duplicates" << endl;
+    cout << "         Stable sorts maintain relative order\n" << endl;
+
+    int duplicateSize = 5000;
+    cout << "Only 10 Unique Values, Size: " << duplicateSize << endl;
+    vector<int> duplicateData = generateManyDuplicates(duplicateSize);
+
+    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
+        << measureSortingTime(duplicateData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
+    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
+        << measureSortingTime(duplicateData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
+    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
+        << measureSortingTime(duplicateData, radixSortLSD, "Radix Sort") << " ms" << endl;
+    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
+        << measureSortingTime(duplicateData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
+    cout << "  Bucket Sort:               " << fixed << setprecision(3)
+        << measureSortingTime(duplicateData, bucketSort, "Bucket Sort") << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 7: CONCURRENT STREAMING INGEST
+    // ========================================================================
+    cout << "\nTEST 7: CONCURRENT STREAMING INGEST" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Push keys from several writer threads into StreamingSorter" << endl;
+    cout << "Expected: Ingest scales with writers (lock-free fast path)" << endl;
+    cout << "         Snapshot cost bounded by the unsorted tail plus one merge\n" << endl;
+
+    int keysPerWriter = 50000;
+    vector<int> writerCounts = { 1, 2, 4 };
+
+    for (int writerCount : writerCounts) {
+        cout << "Writers: " << writerCount << ", Keys per Writer: " << keysPerWriter << endl;
+        StreamingSorter streamingSorter(2, 4096, 8);
+        vector<StreamingSorter::Producer*> producers;
+        for (int i = 0; i < writerCount; i++) {
+            producers.push_back(&streamingSorter.createProducer());
+        }
+
+        auto ingestStart = high_resolution_clock::now();
+        vector<thread> writers;
+        for (int i = 0; i < writerCount; i++) {
+            StreamingSorter::Producer* producer = producers[i];
+            writers.push_back(thread([producer, keysPerWriter, i]() {
+                mt19937 generator(i + 1);
+                uniform_int_distribution<> distribution(0, 1000000);
+                for (int k = 0; k < keysPerWriter; k++) {
+                    producer->push(distribution(generator));
+                }
+            }));
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        duration<double, milli> ingestTime = high_resolution_clock::now() - ingestStart;
+
+        auto snapshotStart = high_resolution_clock::now();
+        vector<int> snapshot = streamingSorter.snapshot();
+        duration<double, milli> snapshotTime = high_resolution_clock::now() - snapshotStart;
+
+        if (!isSorted(snapshot) || snapshot.size() != static_cast<size_t>(writerCount) * keysPerWriter) {
+            cout << "ERROR: StreamingSorter snapshot is incomplete or unsorted!" << endl;
+        }
+
+        // A second snapshot after a small top-up merges only the new runs and tail
+        int topUpKeys = keysPerWriter / 10;
+        for (int k = 0; k < topUpKeys; k++) {
+            producers[0]->push(k * 7 % 1000001);
+        }
+        auto repeatStart = high_resolution_clock::now();
+        vector<int> repeatSnapshot = streamingSorter.snapshot();
+        duration<double, milli> repeatTime = high_resolution_clock::now() - repeatStart;
+
+        if (!isSorted(repeatSnapshot) || repeatSnapshot.size() != snapshot.size() + topUpKeys) {
+            cout << "ERROR: Repeated StreamingSorter snapshot is incomplete or unsorted!" << endl;
+        }
+        cout << "  Ingest:                    " << fixed << setprecision(3) << ingestTime.count() << " ms ("
+            << setprecision(1) << (writerCount * keysPerWriter) / ingestTime.count() / 1000.0 << " M keys/s)" << endl;
+        cout << "  Snapshot:                  " << fixed << setprecision(3) << snapshotTime.count() << " ms" << endl;
+        cout << "  Snapshot after +10%:       " << repeatTime.count() << " ms" << endl;
+        cout << endl;
+    }
+
+    // Keys over the whole int range, negatives included, in full chunks and the tail
+    {
+        StreamingSorter signedSorter(2, 4096, 8);
+        vector<StreamingSorter::Producer*> signedProducers = { &signedSorter.createProducer(), &signedSorter.createProducer() };
+        vector<vector<int>> pushedKeys(signedProducers.size());
+        vector<thread> signedWriters;
+        for (size_t i = 0; i < signedProducers.size(); i++) {
+            signedWriters.push_back(thread([&signedProducers, &pushedKeys, i, keysPerWriter]() {
+                mt19937 generator(static_cast<unsigned>(i + 101));
+                uniform_int_distribution<int> distribution(numeric_limits<int>::min(), numeric_limits<int>::max());
+                for (int k = 0; k < keysPerWriter; k++) {
+                    int value = k % 1000 == 0 ? (k % 2000 == 0 ? numeric_limits<int>::min() : numeric_limits<int>::max())
+                        : distribution(generator);
+                    pushedKeys[i].push_back(value);
+                    signedProducers[i]->push(value);
+                }
+            }));
+        }
+        for (auto& writer : signedWriters) {
+            writer.join();
+        }
+        vector<int> signedSnapshot = signedSorter.snapshot();
+        vector<int> expectedKeys;
+        for (const vector<int>& keys : pushedKeys) {
+            expectedKeys.insert(expectedKeys.end(), keys.begin(), keys.end());
+        }
+        sort(expectedKeys.begin(), expectedKeys.end());
+        bool signedCorrect = signedSnapshot == expectedKeys;
+        if (!signedCorrect) {
+            cout << "ERROR: StreamingSorter snapshot of signed keys is wrong!" << endl;
+        }
+        cout << "Signed keys (full int range, 2 writers): " << (signedCorrect ? "sorted correctly" : "FAILED") << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 8: SEARCH INDEX VS BINARY SEARCH
+    // ========================================================================
+    cout << "\nTEST 8: SEARCH INDEX VS BINARY SEARCH" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Compare lower_bound on sorted output with an Eytzinger index" << endl;
+    cout << "Expected: Eytzinger layout wins once the array exceeds the cache" << endl;
+    cout << "         Batched lookups hide more memory latency\n" << endl;
+
+    vector<int> indexSizes = { 10000, 1000000 };
+    int queryCount = 200000;
+
+    for (int size : indexSizes) {
+        cout << "Sorted Size: " << size << ", Queries: " << queryCount << endl;
+        vector<int> sortedData = generateLargeRangeFewRepeats(size);
+        radixSortLSD(sortedData);
+        vector<int> queries = generateLargeRangeFewRepeats(queryCount, TEST_CASE_SEED + 1);
+
+        auto buildStart = high_resolution_clock::now();
+        EytzingerIndex searchIndex(sortedData);
+        duration<double, milli> buildTime = high_resolution_clock::now() - buildStart;
+
+        vector<size_t> expected(queryCount);
+        auto binaryStart = high_resolution_clock::now();
+        for (int q = 0; q < queryCount; q++) {
+            expected[q] = lower_bound(sortedData.begin(), sortedData.end(), queries[q]) - sortedData.begin();
+        }
+        duration<double, milli> binaryTime = high_resolution_clock::now() - binaryStart;
+
+        vector<size_t> single(queryCount);
+        auto singleStart = high_resolution_clock::now();
+        for (int q = 0; q < queryCount; q++) {
+            single[q] = searchIndex.lowerBound(queries[q]);
+        }
+        duration<double, milli> singleTime = high_resolution_clock::now() - singleStart;
+
+        auto batchStart = high_resolution_clock::now();
+        vector<size_t> batched = searchIndex.lowerBoundBatch(queries);
+        duration<double, milli> batchTime = high_resolution_clock::now() - batchStart;
+
+        if (single != expected || batched != expected) {
+            cout << "ERROR: EytzingerIndex lookups disagree with std::lower_bound!" << endl;
+        }
+        cout << "  Index Build:               " << fixed << setprecision(3) << buildTime.count() << " ms" << endl;
+        cout << "  std::lower_bound:          " << fixed << setprecision(3) << binaryTime.count() << " ms" << endl;
+        cout << "  Eytzinger lowerBound:      " << fixed << setprecision(3) << singleTime.count() << " ms" << endl;
+        cout << "  Eytzinger Batched:         " << fixed << setprecision(3) << batchTime.count() << " ms" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 9: INDIRECT SORT OF LARGE RECORDS
+    // ========================================================================
+    cout << "\nTEST 9: INDIRECT SORT OF LARGE RECORDS" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Find the record size where sorting (key, index) pairs wins" << endl;
+    cout << "Expected: Direct radix wins for small records" << endl;
+    cout << "         Indirect sort wins as records grow past a cache line\n" << endl;
+
+    int recordCount = 50000;
+    runIndirectSortBenchmark<16>(recordCount);
+    runIndirectSortBenchmark<64>(recordCount);
+    runIndirectSortBenchmark<128>(recordCount);
+    runIndirectSortBenchmark<256>(recordCount);
+    runIndirectSortBenchmark<512>(recordCount);
+
+    // ========================================================================
+    // TEST 10: COLUMNAR SORT (ONE KEY, MANY PAYLOAD COLUMNS)
+    // ========================================================================
+    cout << "\nTEST 10: COLUMNAR SORT (ONE KEY, MANY PAYLOAD COLUMNS)" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Reorder payload columns by one sorted key column" << endl;
+    cout << "Expected: Sorting the key once beats sorting every column separately" << endl;
+    cout << "         Column reordering scales with threads\n" << endl;
+
+    int rowCount = 100000;
+    int payloadColumnCount = 20;
+    int columnThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    cout << "Rows: " << rowCount << ", Payload Columns: " << payloadColumnCount
+        << ", Threads: " << columnThreads << endl;
+
+    vector<int> keyColumn = generateLargeRangeFewRepeats(rowCount);
+    vector<vector<int>> payloadColumns(payloadColumnCount, vector<int>(rowCount));
+    for (int c = 0; c < payloadColumnCount; c++) {
+        for (int r = 0; r < rowCount; r++) {
+            payloadColumns[c][r] = r * payloadColumnCount + c;
+        }
+    }
+
+    // Baseline: every column is sorted on its own as (key, value) pairs
+    vector<vector<int>> perColumnResult = payloadColumns;
+    auto perColumnStart = high_resolution_clock::now();
+    for (auto& column : perColumnResult) {
+        vector<pair<uint32_t, int>> keyed(rowCount);
+        for (int r = 0; r < rowCount; r++) {
+            keyed[r] = make_pair(radixKeyOf(keyColumn[r]), column[r]);
+        }
+        radixSortByteLSD(keyed, [](const pair<uint32_t, int>& entry) { return entry.first; });
+        for (int r = 0; r < rowCount; r++) {
+            column[r] = keyed[r].second;
+        }
+    }
+    duration<double, milli> perColumnTime = high_resolution_clock::now() - perColumnStart;
+
+    vector<int> gatherKeys = keyColumn;
+    vector<vector<int>> gatherColumns = payloadColumns;
+    auto columnGatherStart = high_resolution_clock::now();
+    sortColumnsByKey(gatherKeys, gatherColumns, columnThreads);
+    duration<double, milli> columnGatherTime = high_resolution_clock::now() - columnGatherStart;
+
+    vector<int> inPlaceKeys = keyColumn;
+    vector<vector<int>> inPlaceColumns = payloadColumns;
+    auto columnInPlaceStart = high_resolution_clock::now();
+    sortColumnsByKey(inPlaceKeys, inPlaceColumns, columnThreads, true);
+    duration<double, milli> columnInPlaceTime = high_resolution_clock::now() - columnInPlaceStart;
+
+    if (!isSorted(gatherKeys) || gatherColumns != perColumnResult || inPlaceColumns != perColumnResult) {
+        cout << "ERROR: Columnar sort produced a different row order!" << endl;
+    }
+    cout << "  Sort Each Column:          " << fixed << setprecision(3) << perColumnTime.count() << " ms" << endl;
+    cout << "  Sort Key + Gather:         " << fixed << setprecision(3) << columnGatherTime.count() << " ms" << endl;
+    cout << "  Sort Key + In-Place:       " << fixed << setprecision(3) << columnInPlaceTime.count() << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 11: STABLE IN-PLACE RADIX SORT
+    // ========================================================================
+    cout << "\nTEST 11: STABLE IN-PLACE RADIX SORT" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Trade time for memory in stable radix sorting" << endl;
+    cout << "Expected: Out-of-place radix is fastest but needs an n-sized copy" << endl;
+    cout << "         In-place version needs only a sqrt(n) buffer\n" << endl;
+
+    vector<int> stableSizes = { 10000, 200000 };
+    auto signedKey = [](int value) { return radixKeyOf(value); };
+
+    for (int size : stableSizes) {
+        cout << "Input Size: " << size << endl;
+        vector<int> testData = generateLargeRangeFewRepeats(size);
+        size_t defaultBuffer = max<size_t>(256, static_cast<size_t>(sqrt(static_cast<double>(size))));
+
+        cout << "  Out-of-Place Byte Radix:   " << fixed << setprecision(3)
+            << measureSortingTime(testData, [&](vector<int>& array) { radixSortByteLSD(array, signedKey); },
+                "Byte Radix Sort") << " ms, extra "
+            << (size * sizeof(int) + 4 * 256 * sizeof(size_t)) / 1024 << " KB" << endl;
+        cout << "  In-Place (sqrt(n) buffer): " << fixed << setprecision(3)
+            << measureSortingTime(testData, [&](vector<int>& array) { stableRadixSortInPlace(array, signedKey); },
+                "Stable In-Place Radix Sort") << " ms, extra "
+            << (defaultBuffer * sizeof(int)) / 1024 << " KB" << endl;
+        cout << "  In-Place (4096 buffer):    " << fixed << setprecision(3)
+            << measureSortingTime(testData, [&](vector<int>& array) { stableRadixSortInPlace(array, signedKey, 4096); },
+                "Stable In-Place Radix Sort") << " ms, extra "
+            << (min<size_t>(4096, size) * sizeof(int)) / 1024 << " KB" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 12: PARALLEL IN-PLACE RADIX SORT
+    // ========================================================================
+    cout << "\nTEST 12: PARALLEL IN-PLACE RADIX SORT" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Sort in place on all cores without an n-sized scratch array" << endl;
+    cout << "Expected: Throughput grows with threads" << endl;
+    cout << "         Extra memory stays at O(threads x 256) counters\n" << endl;
+
+    int parallelSize = 1000000;
+    int hardwareThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    cout << "Input Size: " << parallelSize << ", Hardware Threads: " << hardwareThreads << endl;
+    vector<int> parallelData = generateLargeRangeFewRepeats(parallelSize);
+
+    cout << "  std::sort:                 " << fixed << setprecision(3)
+        << measureSortingTime(parallelData, [](vector<int>& array) { sort(array.begin(), array.end()); },
+            "std::sort") << " ms" << endl;
+    cout << "  Out-of-Place Byte Radix:   " << fixed << setprecision(3)
+        << measureSortingTime(parallelData, [&](vector<int>& array) { radixSortByteLSD(array, signedKey); },
+            "Byte Radix Sort") << " ms" << endl;
+    cout << "  In-Place MSD (1 thread):   " << fixed << setprecision(3)
+        << measureSortingTime(parallelData, [&](vector<int>& array) { parallelRadixSortInPlace(array, signedKey, 1); },
+            "Parallel In-Place Radix Sort") << " ms" << endl;
+    cout << "  In-Place MSD (" << hardwareThreads << " threads):  " << fixed << setprecision(3)
+        << measureSortingTime(parallelData, [&](vector<int>& array) {
+            parallelRadixSortInPlace(array, signedKey, hardwareThreads);
+        }, "Parallel In-Place Radix Sort") << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 13: CONCURRENT SORTS UNDER A MEMORY BUDGET
+    // ========================================================================
+    cout << "\nTEST 13: CONCURRENT SORTS UNDER A MEMORY BUDGET" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Run 32 concurrent sorts (8 engines) against a shared scratch budget" << endl;
+    cout << "Expected: Reserved scratch never exceeds the limit" << endl;
+    cout << "         Sorts that do not fit downgrade to the in-place radix sort\n" << endl;
+
+    int concurrentSorts = 32;
+    int concurrentSize = 100000;
+    vector<size_t> budgetLimits = { 0, 2 * 1024 * 1024 };
+    // Every engine that allocates O(n) or O(range) scratch
+    vector<function<void(vector<int>&)>> budgetedSorts = {
+        countingSortStable,
+        radixSortLSD,
+        countingSortNonStable,
+        pigeonholeSort,
+        bucketSort,
+        bucketSortLearnedCDF,
+        [](vector<int>& array) { radixSortByteLSD(array, [](int value) { return radixKeyOf(value); }); },
+        [](vector<int>& array) { parallelStableMergeSort(array, 2); }
+    };
+
+    for (size_t limit : budgetLimits) {
+        cout << "Budget: " << (limit == 0 ? string("unlimited") : to_string(limit / 1024) + " KB")
+            << ", Sorts: " << concurrentSorts << " x " << concurrentSize << " elements" << endl;
+        MemoryBudget::instance().setLimit(limit);
+        MemoryBudget::instance().resetStatistics();
+
+        vector<vector<int>> inputs;
+        for (int s = 0; s < concurrentSorts; s++) {
+            inputs.push_back(generateLargeRangeFewRepeats(concurrentSize, TEST_CASE_SEED + s));
+        }
+
+        auto budgetStart = high_resolution_clock::now();
+        vector<thread> sorters;
+        for (int s = 0; s < concurrentSorts; s++) {
+            vector<int>* input = &inputs[s];
+            const function<void(vector<int>&)>* sortFunction = &budgetedSorts[s % budgetedSorts.size()];
+            sorters.push_back(thread([input, sortFunction]() { (*sortFunction)(*input); }));
+        }
+        for (auto& sorter : sorters) {
+            sorter.join();
+        }
+        duration<double, milli> budgetTime = high_resolution_clock::now() - budgetStart;
+
+        for (const auto& input : inputs) {
+            if (!isSorted(input)) {
+                cout << "ERROR: Budgeted sort did not sort correctly!" << endl;
+                break;
+            }
+        }
+        cout << "  Wall Time:                 " << fixed << setprecision(3) << budgetTime.count() << " ms" << endl;
+        cout << "  Peak Reserved Scratch:     " << MemoryBudget::instance().peakReservedBytes() / 1024 << " KB" << endl;
+        cout << "  Downgrades:                " << MemoryBudget::instance().downgradeCount() << endl;
+        cout << endl;
+    }
+    MemoryBudget::instance().setLimit(0);
+
+    // ========================================================================
+    // TEST 14: MERGING A DELTA INTO A SORTED ARRAY
+    // ========================================================================
+    cout << "\nTEST 14: MERGING A DELTA INTO A SORTED ARRAY" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Apply small insert/delete batches to a large sorted array" << endl;
+    cout << "Expected: Delta merge costs one pass over the base" << endl;
+    cout << "         Re-sorting costs a full sort every batch\n" << endl;
+
+    int baseSize = 1000000;
+    vector<int> deltaSizes = { 1000, 10000, 100000 };
+    vector<int> sortedBaseData = generateLargeRangeFewRepeats(baseSize);
+    radixSortLSD(sortedBaseData);
+
+    for (int deltaSize : deltaSizes) {
+        cout << "Base Size: " << baseSize << ", Delta: " << deltaSize
+            << ", Tombstones: " << deltaSize / 10 << endl;
+        vector<int> delta = generateLargeRangeFewRepeats(deltaSize, TEST_CASE_SEED + 1);
+        vector<int> tombstones;
+        for (int t = 0; t < deltaSize / 10; t++) {
+            tombstones.push_back(sortedBaseData[(static_cast<size_t>(t) * 7919) % baseSize]);
+        }
+
+        // Baseline: append, re-sort everything, then drop the tombstones
+        vector<int> resorted = sortedBaseData;
+        auto resortStart = high_resolution_clock::now();
+        resorted.insert(resorted.end(), delta.begin(), delta.end());
+        radixSortLSD(resorted);
+        vector<int> sortedTombstones = tombstones;
+        radixSortLSD(sortedTombstones);
+        vector<int> expected;
+        set_difference(resorted.begin(), resorted.end(), sortedTombstones.begin(), sortedTombstones.end(),
+            back_inserter(expected));
+        duration<double, milli> resortTime = high_resolution_clock::now() - resortStart;
+
+        vector<int> merged = sortedBaseData;
+        merged.reserve(merged.size() + delta.size());
+        auto deltaStart = high_resolution_clock::now();
+        mergeDeltaIntoSorted(merged, delta, tombstones);
+        duration<double, milli> deltaTime = high_resolution_clock::now() - deltaStart;
+
+        if (merged != expected) {
+            cout << "ERROR: Delta merge differs from a full re-sort!" << endl;
+        }
+        cout << "  Append + Re-sort:          " << fixed << setprecision(3) << resortTime.count() << " ms" << endl;
+        cout << "  Delta Merge:               " << fixed << setprecision(3) << deltaTime.count() << " ms" << endl;
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 15: PARALLEL STABLE MERGE SORT ON NON-INTEGER KEYS
+    // ========================================================================
+    cout << "\nTEST 15: PARALLEL STABLE MERGE SORT ON NON-INTEGER KEYS" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Stable sort of string-keyed records the radix engines cannot handle" << endl;
+    cout << "Expected: Same order as std::stable_sort" << endl;
+    cout << "         Faster with more threads thanks to balanced merge-path splits\n" << endl;
+
+    int stringRecordCount = 200000;
+    cout << "String Records: " << stringRecordCount << ", Threads: " << mergeSortThreads << endl;
+    vector<pair<string, int>> stringRecords(stringRecordCount);
+    vector<int> stringSeeds = generateLargeRangeFewRepeats(stringRecordCount);
+    for (int r = 0; r < stringRecordCount; r++) {
+        stringRecords[r] = make_pair("key-" + to_string(stringSeeds[r] % 5000), r);
+    }
+    auto byStringKey = [](const pair<string, int>& a, const pair<string, int>& b) { return a.first < b.first; };
+
+    vector<pair<string, int>> stableExpected = stringRecords;
+    auto stableStart = high_resolution_clock::now();
+    stable_sort(stableExpected.begin(), stableExpected.end(), byStringKey);
+    duration<double, milli> stableTime = high_resolution_clock::now() - stableStart;
+
+    vector<pair<string, int>> mergeSorted = stringRecords;
+    auto mergeSortStart = high_resolution_clock::now();
+    parallelStableMergeSort(mergeSorted, byStringKey, mergeSortThreads);
+    duration<double, milli> mergeSortTime = high_resolution_clock::now() - mergeSortStart;
+
+    if (mergeSorted != stableExpected) {
+        cout << "ERROR: Parallel merge sort is not stable or not sorted!" << endl;
+    }
+    cout << "  std::stable_sort:          " << fixed << setprecision(3) << stableTime.count() << " ms" << endl;
+    cout << "  Parallel Merge Sort:       " << fixed << setprecision(3) << mergeSortTime.count() << " ms" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 16: PRODUCTION-LIKE INPUT SHAPES
+    // ========================================================================
+    cout << "\nTEST 16: PRODUCTION-LIKE INPUT SHAPES" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Run every engine on sorted, skewed, wide and clustered inputs" << endl;
+    cout << "Expected: Range-limited engines are skipped on full-range shapes" << endl;
+    cout << "         Radix/comparison engines handle every shape\n" << endl;
+
+    int shapeSize = 20000;
+    unsigned shapeSeed = 2025;
+    vector<SortEngine> engines = sortEngines();
+
+    for (InputShape shape : ALL_INPUT_SHAPES) {
+        cout << shapeName(shape) << " (Size: " << shapeSize << ", Seed: " << shapeSeed << ")" << endl;
+        vector<int> testData = harnessDatasetCache().load(shape, shapeSize, shapeSeed);
+
+        for (const SortEngine& engine : engines) {
+            cout << "  " << left << setw(28) << (engine.name + ":") << right;
+            if (!engineSupports(engine, testData)) {
+                cout << "n/a (input out of range)" << endl;
+                continue;
+            }
+            double measuredMs = measureSortingTime(testData, engine.sort, engine.name);
+            cout << fixed << setprecision(3) << setw(9) << measuredMs << " ms";
+            double efficiency = rooflineEfficiency(engine.minimumTraffic(testData), measuredMs, bandwidth);
+            if (efficiency >= 0) cout << "  (" << setprecision(1) << efficiency << "% of roofline)";
+            cout << endl;
+        }
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 17: BINARY DATASET CACHE
+    // ========================================================================
+    cout << "\nTEST 17: BINARY DATASET CACHE" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Compare regenerating a dataset with reloading it from disk" << endl;
+    cout << "Expected: Cache hits load at page-cache speed" << endl;
+    cout << "         Identical (shape, size, parameters, seed) gives identical data\n" << endl;
+
+    int cachedSize = 5000000;
+    unsigned cachedSeed = 7;
+    DatasetCache& datasetCache = harnessDatasetCache();
+    cout << "Negative Heavy, Size: " << cachedSize << ", Seed: " << cachedSeed << endl;
+
+    auto generateStart = high_resolution_clock::now();
+    vector<int> regenerated = generateShapeArray(NEGATIVE_HEAVY, cachedSize, cachedSeed);
+    duration<double, milli> generateTime = high_resolution_clock::now() - generateStart;
+
+    auto firstLoadStart = high_resolution_clock::now();
+    vector<int> firstLoad = datasetCache.load(NEGATIVE_HEAVY, cachedSize, cachedSeed);
+    duration<double, milli> firstLoadTime = high_resolution_clock::now() - firstLoadStart;
+    bool firstWasHit = datasetCache.lastWasHit();
+
+    auto secondLoadStart = high_resolution_clock::now();
+    vector<int> secondLoad = datasetCache.load(NEGATIVE_HEAVY, cachedSize, cachedSeed);
+    duration<double, milli> secondLoadTime = high_resolution_clock::now() - secondLoadStart;
+
+    if (firstLoad != regenerated || secondLoad != regenerated || !datasetCache.lastWasHit()) {
+        cout << "ERROR: Cached dataset differs from the generated one!" << endl;
+    }
+
+    // The zero-copy path: map the file and read it where it lies
+    auto mapStart = high_resolution_clock::now();
+    unique_ptr<MappedDataset> mappedView = datasetCache.map(NEGATIVE_HEAVY, cachedSize, cachedSeed);
+    long long mappedChecksum = 0;
+    if (mappedView) {
+        const int* mappedKeys = mappedView->data();
+        for (size_t i = 0; i < mappedView->size(); i++) mappedChecksum += mappedKeys[i];
+    }
+    duration<double, milli> mapTime = high_resolution_clock::now() - mapStart;
+    long long expectedChecksum = 0;
+    for (int value : regenerated) expectedChecksum += value;
+    if (!mappedView || !datasetCache.lastWasHit() || mappedChecksum != expectedChecksum) {
+        cout << "ERROR: Mapped dataset differs from the generated one!" << endl;
+    }
+    double datasetMegabytes = cachedSize * sizeof(int) / (1024.0 * 1024.0);
+    cout << "  Generate (mt19937):        " << fixed << setprecision(3) << generateTime.count() << " ms" << endl;
+    cout << "  First Load (" << (firstWasHit ? "hit): " : "miss):") << "         " << fixed << setprecision(3)
+        << firstLoadTime.count() << " ms" << endl;
+    cout << "  Cached Load (hit):         " << fixed << setprecision(3) << secondLoadTime.count() << " ms ("
+        << setprecision(0) << datasetMegabytes / (secondLoadTime.count() / 1000.0) << " MB/s)" << endl;
+    cout << "  Mapped View + Scan (hit):  " << fixed << setprecision(3) << mapTime.count() << " ms ("
+        << setprecision(0) << datasetMegabytes / (mapTime.count() / 1000.0) << " MB/s)" << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 18: ROOFLINE EFFICIENCY
+    // ========================================================================
+    cout << "\nTEST 18: ROOFLINE EFFICIENCY" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Compare each engine with its bandwidth-bound minimum time" << endl;
+    cout << "Expected: Pass-efficient engines approach the roofline" << endl;
+    cout << "         Engines without a pass-based traffic model are skipped\n" << endl;
+
+    int rooflineSize = 4000000;
+    vector<InputShape> rooflineShapes = { NEGATIVE_HEAVY, ZIPF };
+
+    for (InputShape shape : rooflineShapes) {
+        cout << shapeName(shape) << " (Size: " << rooflineSize << ")" << endl;
+        vector<int> testData = harnessDatasetCache().load(shape, rooflineSize, shapeSeed);
+
+        for (const SortEngine& engine : engines) {
+            TrafficEstimate traffic = engine.minimumTraffic(testData);
+            if (traffic.streamedBytes < 0 || !engineSupports(engine, testData)) continue;
+            double measuredMs = measureSortingTime(testData, engine.sort, engine.name);
+            cout << "  " << left << setw(28) << (engine.name + ":") << right
+                << fixed << setprecision(3) << setw(9) << measuredMs << " ms  ("
+                << setprecision(1) << rooflineEfficiency(traffic, measuredMs, bandwidth)
+                << "% of roofline)" << endl;
+        }
+        cout << endl;
+    }
+
+    // ========================================================================
+    // TEST 19: WIDE FIXED-WIDTH KEYS
+    // ========================================================================
+    cout << "\nTEST 19: WIDE FIXED-WIDTH KEYS" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Sort UUIDs, SHA-1 digests and 128-bit integers" << endl;
+    cout << "Expected: MSD radix beats std::sort with memcmp comparisons" << endl;
+    cout << "         Shared prefixes are skipped instead of costing a pass per byte\n" << endl;
+
+    int wideKeyCount = 500000;
+    mt19937 wideGenerator(91);
+    auto memcmpLess = [](const Uuid& a, const Uuid& b) { return memcmp(a.bytes, b.bytes, 16) < 0; };
+
+    vector<Uuid> randomUuids(wideKeyCount);
+    for (Uuid& uuid : randomUuids) uuid = randomFixedWidthKey<16>(wideGenerator);
+    runWideKeyBenchmark("Random UUIDs (v4)", randomUuids, memcmpLess, sortFixedWidthKeys<16>);
+
+    // Time-ordered UUIDs from one minute: the first 4 timestamp bytes are shared
+    vector<Uuid> timeUuids(wideKeyCount);
+    uint64_t baseMillis = 1760000000000ULL;
+    for (Uuid& uuid : timeUuids) {
+        uuid = randomFixedWidthKey<16>(wideGenerator);
+        uint64_t millis = baseMillis + wideGenerator() % 60000;
+        for (int b = 0; b < 6; b++) uuid.bytes[b] = static_cast<uint8_t>(millis >> (8 * (5 - b)));
+    }
+    runWideKeyBenchmark("Time-Ordered UUIDs (v7, one minute)", timeUuids, memcmpLess, sortFixedWidthKeys<16>);
+
+    vector<Sha1Digest> digests(wideKeyCount);
+    for (Sha1Digest& digest : digests) digest = randomFixedWidthKey<20>(wideGenerator);
+    runWideKeyBenchmark("SHA-1 Digests", digests,
+        [](const Sha1Digest& a, const Sha1Digest& b) { return memcmp(a.bytes, b.bytes, 20) < 0; },
+        sortFixedWidthKeys<20>);
+
+    // Few distinct UUIDs so stability of the row payload is exercised
+    vector<UuidRow> uuidRows(wideKeyCount);
+    for (int r = 0; r < wideKeyCount; r++) {
+        uuidRows[r].key = randomUuids[wideGenerator() % 1000];
+        uuidRows[r].row = static_cast<uint32_t>(r);
+    }
+    runWideKeyBenchmark("UUID + Row Payload (1,000 distinct)", uuidRows,
+        [](const UuidRow& a, const UuidRow& b) { return memcmp(a.key.bytes, b.key.bytes, 16) < 0; },
+        [](vector<UuidRow>& records) {
+            radixSortWideMSD(records, [](const UuidRow& record, size_t depth) { return record.key.bytes[depth]; }, 16);
+        });
+
+#ifdef __SIZEOF_INT128__
+    vector<__int128> wideIntegers(wideKeyCount);
+    for (__int128& value : wideIntegers) {
+        value = static_cast<__int128>((static_cast<unsigned __int128>(wideGenerator()) << 96) |
+            (static_cast<unsigned __int128>(wideGenerator()) << 64) | (static_cast<uint64_t>(wideGenerator()) << 32) |
+            wideGenerator());
+    }
+    runWideKeyBenchmark("Signed __int128", wideIntegers, [](__int128 a, __int128 b) { return a < b; }, sortInt128);
+#endif
+
+    // ========================================================================
+    // TEST 20: DESCENDING ORDER WITHOUT A REVERSE PASS
+    // ========================================================================
+    cout << "\nTEST 20: DESCENDING ORDER WITHOUT A REVERSE PASS" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Compare ascending + std::reverse with native descending modes" << endl;
+    cout << "Expected: Descending costs the same as ascending, saving the reverse pass" << endl;
+    cout << "         Only the native mode keeps equal keys in input order\n" << endl;
+
+    int descendingSize = 1000000;
+    vector<int> descendingData = generateVaryingRangeArray(descendingSize, 100000);
+    auto isSortedDescending = [](const vector<int>& array) { return is_sorted(array.begin(), array.end(), greater<int>()); };
+    vector<pair<string, pair<function<void(vector<int>&)>, function<void(vector<int>&)>>>> orderedEngines = {
+        { "Counting Sort (Stable)", { countingSortStable, countingSortStableDescending } },
+        { "Radix Sort (LSD)", { radixSortLSD, radixSortLSDDescending } },
+        { "Byte Radix (LSD)", {
+            [](vector<int>& array) { radixSortByteLSD(array, [](int value) { return radixKeyOf(value); }); },
+            [](vector<int>& array) { radixSortByteLSD(array, [](int value) { return radixKeyOfDescending(value); }); } } },
+        { "Bucket Sort", { bucketSort, bucketSortDescending } }
+    };
+
+    cout << "Size: " << descendingSize << ", Range: [0, 100000]" << endl;
+    for (const auto& engine : orderedEngines) {
+        vector<int> reversed = descendingData;
+        auto reverseStart = high_resolution_clock::now();
+        engine.second.first(reversed);
+        reverse(reversed.begin(), reversed.end());
+        duration<double, milli> reverseTime = high_resolution_clock::now() - reverseStart;
+
+        vector<int> native = descendingData;
+        auto nativeStart = high_resolution_clock::now();
+        engine.second.second(native);
+        duration<double, milli> nativeTime = high_resolution_clock::now() - nativeStart;
+
+        if (!isSortedDescending(native) || native != reversed) {
+            cout << "ERROR: " << engine.first << " descending mode did not sort correctly!" << endl;
+        }
+        cout << "  " << left << setw(26) << engine.first << right << " Ascending + Reverse: " << fixed << setprecision(3)
+            << setw(9) << reverseTime.count() << " ms   Descending: " << setw(9) << nativeTime.count() << " ms" << endl;
+    }
+
+    // Stability on (key, arrival) records: reversing flips every run of equal keys
+    vector<pair<int, int>> arrivals(descendingSize);
+    for (int i = 0; i < descendingSize; i++) {
+        arrivals[i] = make_pair(descendingData[i] % 1000, i);
+    }
+    auto countUnstableRuns = [](const vector<pair<int, int>>& records) {
+        int unstable = 0;
+        for (size_t i = 1; i < records.size(); i++) {
+            if (records[i].first == records[i - 1].first && records[i].second < records[i - 1].second) unstable++;
+        }
+        return unstable;
+    };
+    vector<pair<int, int>> reversedArrivals = arrivals;
+    radixSortByteLSD(reversedArrivals, [](const pair<int, int>& record) { return radixKeyOf(record.first); });
+    reverse(reversedArrivals.begin(), reversedArrivals.end());
+    vector<pair<int, int>> nativeArrivals = arrivals;
+    radixSortByteLSD(nativeArrivals, [](const pair<int, int>& record) { return radixKeyOfDescending(record.first); });
+
+    vector<pair<int, int>> expectedArrivals = arrivals;
+    stable_sort(expectedArrivals.begin(), expectedArrivals.end(),
+        [](const pair<int, int>& a, const pair<int, int>& b) { return a.first > b.first; });
+    if (nativeArrivals != expectedArrivals) {
+        cout << "ERROR: Descending byte radix is not stable!" << endl;
+    }
+    cout << "  Records out of arrival order (1,000 distinct keys):" << endl;
+    cout << "    Ascending + Reverse:     " << countUnstableRuns(reversedArrivals) << endl;
+    cout << "    Descending Key:          " << countUnstableRuns(nativeArrivals) << endl;
+    cout << endl;
+
+    // ========================================================================
+    // TEST 21: RANGE PARTITIONING
+    // ========================================================================
+    cout << "\nTEST 21: RANGE PARTITIONING" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Split keys into P contiguous value ranges without sorting them" << endl;
+    cout << "Expected: One classification + one scatter pass beats a full sort" << endl;
+    cout << "         Every key lands in the range its partition covers\n" << endl;
+
+    int partitionSize = 4000000;
+    int partitionThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    vector<int> partitionThreadCounts = { 1 };
+    if (partitionThreads > 1) partitionThreadCounts.push_back(partitionThreads);
+    vector<int> partitionData = harnessDatasetCache().load(NEGATIVE_HEAVY, partitionSize, shapeSeed);
+    cout << "Negative Heavy, Size: " << partitionSize << ", Threads: " << partitionThreads << endl;
+    cout << "  Full Sort (Byte Radix):    " << fixed << setprecision(3)
+        << measureSortingTime(partitionData, [&](vector<int>& array) { radixSortByteLSD(array, signedKey); },
+            "Byte Radix") << " ms" << endl;
+
+    for (size_t partitionCount : { 64, 1024 }) {
+        // Splitters at evenly spaced ranks of a sorted sample
+        vector<int> sample;
+        for (size_t i = 0; i < partitionData.size(); i += 997) sample.push_back(partitionData[i]);
+        sort(sample.begin(), sample.end());
+        vector<int> splitters;
+        for (size_t p = 1; p < partitionCount; p++) splitters.push_back(sample[p * sample.size() / partitionCount]);
 
-    for (int i = 0; i < size; i++) {
-        result[i] = distribution(generator);
+        auto checkPartitions = [&](const PartitionResult& result, const vector<int>& bounds, const string& name) {
+            bool valid = result.values.size() == partitionData.size() && result.offsets.back() == partitionData.size();
+            for (size_t p = 0; valid && p + 1 < result.offsets.size(); p++) {
+                for (size_t i = result.offsets[p]; i < result.offsets[p + 1]; i++) {
+                    if ((p > 0 && result.values[i] < bounds[p - 1]) || (p < bounds.size() && result.values[i] >= bounds[p])) {
+                        valid = false;
+                        break;
+                    }
+                }
+            }
+            if (!valid) cout << "ERROR: " << name << " produced a key outside its partition!" << endl;
+        };
+
+        cout << "  P = " << partitionCount << endl;
+        for (int threads : partitionThreadCounts) {
+            auto splitterStart = high_resolution_clock::now();
+            PartitionResult bySplitters = partitionBySplitters(partitionData, splitters, threads);
+            duration<double, milli> splitterTime = high_resolution_clock::now() - splitterStart;
+            checkPartitions(bySplitters, splitters, "partitionBySplitters");
+            cout << "    Splitters (" << threads << " thread" << (threads == 1 ? "):     " : "s):   ")
+                << fixed << setprecision(3) << splitterTime.count() << " ms" << endl;
+        }
+
+        auto widthStart = high_resolution_clock::now();
+        PartitionResult byWidth = partitionEqualWidth(partitionData, partitionCount, partitionThreads);
+        duration<double, milli> widthTime = high_resolution_clock::now() - widthStart;
+        long long minValue = *min_element(partitionData.begin(), partitionData.end());
+        long long range = *max_element(partitionData.begin(), partitionData.end()) - minValue + 1;
+        vector<int> binBounds;
+        for (size_t p = 1; p < partitionCount; p++) {
+            binBounds.push_back(static_cast<int>(minValue + (static_cast<long long>(p) * range + partitionCount - 1) / partitionCount));
+        }
+        checkPartitions(byWidth, binBounds, "partitionEqualWidth");
+        cout << "    Equal Width:             " << fixed << setprecision(3) << widthTime.count() << " ms" << endl;
     }
-    return result;
-}
+    cout << endl;
 
-// ============================================================================
-// EXPERIMENTAL TEST SUITE
-// ============================================================================
+    // ========================================================================
+    // TEST 22: DISTRIBUTED SAMPLE SORT (LOCAL PROCESSES)
+    // ========================================================================
+    cout << "\nTEST 22: DISTRIBUTED SAMPLE SORT (LOCAL PROCESSES)" << endl;
+    cout << "------------------------------------------------------------" << endl;
+    cout << "Purpose: Measure shuffle cost against local sort cost as processes grow" << endl;
+    cout << "Expected: Local sort time falls roughly as 1/P given a core per process" << endl;
+    cout << "         Shuffled bytes grow towards n x 4 x (P - 1) / P\n" << endl;
 
-void runExperimentalTests() {
-    cout << "\n============================================" << endl;
-    cout << "   EXPERIMENTAL TEST CASES" << endl;
-    cout << "============================================\n" << endl;
+    int distributedSize = 4000000;
+    vector<int> distributedData = harnessDatasetCache().load(NEGATIVE_HEAVY, distributedSize, shapeSeed);
+    vector<int> distributedExpected = distributedData;
+    radixSortByteLSD(distributedExpected, signedKey);
+    cout << "Negative Heavy, Size: " << distributedSize << ", 256 samples per process" << endl;
+    cout << "  " << left << setw(11) << "Processes" << right << setw(10) << "Sample" << setw(11) << "Partition"
+        << setw(10) << "Shuffle" << setw(12) << "Local Sort" << setw(10) << "Total" << setw(14) << "Shuffled MB" << endl;
+    for (int processCount : { 1, 2, 4, 8 }) {
+        vector<int> distributed = distributedData;
+        DistributedSortReport report = distributedSampleSort(distributed, processCount);
+        if (!report.succeeded || distributed != distributedExpected) {
+            cout << "ERROR: Distributed sample sort failed with " << processCount << " processes!" << endl;
+            continue;
+        }
+        cout << "  " << left << setw(11) << processCount << right << fixed << setprecision(2)
+            << setw(10) << report.sampleMs << setw(11) << report.partitionMs << setw(10) << report.shuffleMs
+            << setw(12) << report.localSortMs << setw(10) << report.totalMs
+            << setw(14) << report.bytesShuffled / (1024.0 * 1024.0) << endl;
+    }
+    cout << "  (phase times in ms, slowest process per phase)" << endl;
+    cout << endl;
 
+#if defined(__unix__) || defined(__APPLE__)
     // ========================================================================
-    // TEST 1: VARYING INPUT RANGE SIZE
+    // TEST 23: SHARED-MEMORY SORT SERVICE
     // ========================================================================
-    cout << "TEST 1: VARYING INPUT RANGE SIZE" << endl;
+    cout << "\nTEST 23: SHARED-MEMORY SORT SERVICE" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Evaluate performance with different value ranges" << endl;
-    cout << "Expected: Counting sort struggles with large ranges" << endl;
-    cout << "         Radix/Bucket sort relatively unaffected\n" << endl;
+    cout << "Purpose: Compare clients that embed their own engine with one shared daemon" << endl;
+    cout << "Expected: The daemon caps sorting threads at the core count" << endl;
+    cout << "         Keys are sorted in the clients' own shared pages (no copies)\n" << endl;
 
-    vector<int> rangeSizes = { 100, 1000, 10000, 100000 };
-    int fixedSize = 1000;
+    int serviceClients = 4;
+    int serviceJobsPerClient = 4;
+    int serviceJobSize = 250000;
+    int serviceThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    string servicePath = "/tmp/sorting_demo_" + to_string(getpid()) + ".sock";
 
-    for (int range : rangeSizes) {
-        cout << "Range [0, " << range << "], Size: " << fixedSize << endl;
-        vector<int> testData = generateVaryingRangeArray(fixedSize, range);
+    // Run one process per client; a client exits 0 only if all its arrays came back sorted
+    auto runClientProcesses = [&](function<bool(int)> client) {
+        cout.flush();
+        auto clientsStart = high_resolution_clock::now();
+        vector<pid_t> clients;
+        for (int c = 0; c < serviceClients; c++) {
+            pid_t pid = fork();
+            if (pid == 0) _exit(client(c) ? 0 : 1);
+            if (pid > 0) clients.push_back(pid);
+        }
+        bool allSorted = static_cast<int>(clients.size()) == serviceClients;
+        for (pid_t pid : clients) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            allSorted = allSorted && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        if (!allSorted) cout << "ERROR: A sort service client received unsorted data!" << endl;
+        duration<double, milli> clientsTime = high_resolution_clock::now() - clientsStart;
+        return clientsTime.count();
+    };
 
-        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
-        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-        cout << "  Bucket Sort:               " << fixed << setprecision(3)
-            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
-        cout << endl;
+    double embeddedTime = runClientProcesses([&](int c) {
+        bool sorted = true;
+        for (int job = 0; job < serviceJobsPerClient; job++) {
+            vector<int> keys = harnessDatasetCache().load(NEGATIVE_HEAVY, serviceJobSize, shapeSeed + c * 100 + job);
+            parallelRadixSortInPlace(keys, signedKey, serviceThreads);
+            sorted = sorted && isSorted(keys);
+        }
+        return sorted;
+    });
+
+    cout.flush();
+    pid_t daemonPid = fork();
+    if (daemonPid == 0) {
+        SortService service(servicePath, serviceThreads);
+        _exit(service.run() ? 0 : 1);
     }
+    // Wait for the daemon to start listening
+    for (int attempt = 0; attempt < 200 && !SortServiceClient(servicePath).connected(); attempt++) {
+        this_thread::sleep_for(milliseconds(10));
+    }
+    double serviceTime = runClientProcesses([&](int c) {
+        SortServiceClient client(servicePath);
+        bool sorted = client.connected();
+        for (int job = 0; job < serviceJobsPerClient && sorted; job++) {
+            // The client loads its keys from the dataset cache straight into the
+            // shared segment; the service then sorts those pages in place
+            SharedSortBuffer buffer(serviceJobSize);
+            if (!buffer.valid()) return false;
+            harnessDatasetCache().loadInto(NEGATIVE_HEAVY, serviceJobSize, shapeSeed + c * 100 + job, buffer.data());
+            sorted = client.sort(buffer) && is_sorted(buffer.data(), buffer.data() + buffer.size());
+        }
+        return sorted;
+    });
+    SortServiceClient(servicePath).requestShutdown();
+    int daemonStatus = 0;
+    if (daemonPid > 0) waitpid(daemonPid, &daemonStatus, 0);
+
+    cout << "Clients: " << serviceClients << " x " << serviceJobsPerClient << " arrays of " << serviceJobSize
+        << " keys, Engine Threads: " << serviceThreads << endl;
+    cout << "  Embedded Engines:          " << fixed << setprecision(3) << embeddedTime << " ms (up to "
+        << serviceClients * serviceThreads << " sorting threads)" << endl;
+    cout << "  Sort Service:              " << fixed << setprecision(3) << serviceTime << " ms (up to "
+        << serviceThreads << " sorting threads)" << endl;
+    cout << endl;
+#endif
 
     // ========================================================================
-    // TEST 2: DIFFERENT DATA DISTRIBUTIONS
+    // TEST 24: SPACE-FILLING CURVE SORT
     // ========================================================================
-    cout << "\nTEST 2: DIFFERENT DATA DISTRIBUTIONS" << endl;
+    cout << "\nTEST 24: SPACE-FILLING CURVE SORT" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Test algorithms on uniform, normal, and skewed data" << endl;
-    cout << "Expected: Bucket sort performs best on uniform distribution" << endl;
-    cout << "         Others less affected by distribution\n" << endl;
-
-    int distributionTestSize = 5000;
-    vector<string> distributionNames = { "Uniform", "Normal", "Skewed", "Exponential" };
-    vector<Distribution> distributions = { UNIFORM, NORMAL, SKEWED, EXPONENTIAL };
-
-    for (size_t i = 0; i < distributions.size(); i++) {
-        cout << distributionNames[i] << " Distribution (Size: " << distributionTestSize << ")" << endl;
-        vector<int> testData = generateDistributionArray(distributionTestSize, distributions[i]);
+    cout << "Purpose: Order point clouds along Morton and Hilbert curves for locality" << endl;
+    cout << "Expected: Radix on 64-bit codes beats std::sort on the same pairs" << endl;
+    cout << "         Hilbert order gives shorter steps between consecutive points\n" << endl;
 
-        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
-        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-        cout << "  Bucket Sort:               " << fixed << setprecision(3)
-            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
-        cout << endl;
+    size_t pointCount = 10000000;
+#ifdef __BMI2__
+    cout << "Morton encoding: BMI2 pdep" << endl << endl;
+#else
+    cout << "Morton encoding: shift-and-mask (compile with -mbmi2 for pdep)" << endl << endl;
+#endif
+    {
+        vector<PointRecord2D> points2D = harnessDatasetCache().loadOrGenerate<PointRecord2D>(
+            "points2d_n" + to_string(pointCount) + "_s96",
+            [&]() { return generatePointCloud<PointRecord2D>(pointCount, 96, 2); });
+        runCurveSortBenchmark("2D Morton", points2D, 2, [](const PointRecord2D& point) {
+            return mortonCode2D(quantizeCoordinate(point.coords[0], 0, 1000, 32),
+                quantizeCoordinate(point.coords[1], 0, 1000, 32));
+        });
+        runCurveSortBenchmark("2D Hilbert", points2D, 2, [](const PointRecord2D& point) {
+            return hilbertCode2D(quantizeCoordinate(point.coords[0], 0, 1000, 32),
+                quantizeCoordinate(point.coords[1], 0, 1000, 32));
+        });
+    }
+    {
+        vector<PointRecord3D> points3D = harnessDatasetCache().loadOrGenerate<PointRecord3D>(
+            "points3d_n" + to_string(pointCount) + "_s96",
+            [&]() { return generatePointCloud<PointRecord3D>(pointCount, 96, 3); });
+        runCurveSortBenchmark("3D Morton", points3D, 3, [](const PointRecord3D& point) {
+            return mortonCode3D(quantizeCoordinate(point.coords[0], 0, 1000, 21),
+                quantizeCoordinate(point.coords[1], 0, 1000, 21), quantizeCoordinate(point.coords[2], 0, 1000, 21));
+        });
     }
 
     // ========================================================================
-    // TEST 3: VARYING INPUT SIZE (SCALABILITY TEST)
+    // TEST 25: GROUPING BY KEY (CSR BUILDER)
     // ========================================================================
-    cout << "\nTEST 3: VARYING INPUT SIZE (SCALABILITY TEST)" << endl;
+    cout << "\nTEST 25: GROUPING BY KEY (CSR BUILDER)" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Evaluate how algorithms scale with input size" << endl;
-    cout << "Expected: Linear growth for counting/radix/pigeonhole" << endl;
-    cout << "         Potential quadratic for bucket sort in worst case\n" << endl;
+    cout << "Purpose: Build graph adjacency (CSR) from an edge list" << endl;
+    cout << "Expected: One counting pass + one scatter beats sorting the edges" << endl;
+    cout << "         Groups keep edge order unless neighbours are sorted\n" << endl;
 
-    vector<int> inputSizes = { 1000, 5000, 10000, 20000 };
+    size_t vertexCount = 1000000;
+    size_t edgeCount = 16000000;
+    int groupingThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    vector<pair<uint32_t, uint32_t>> edges = harnessDatasetCache().loadOrGenerate<pair<uint32_t, uint32_t>>(
+        "edges_v" + to_string(vertexCount) + "_e" + to_string(edgeCount) + "_s97", [&]() {
+        // Skewed out-degrees: low vertex ids are hubs
+        vector<pair<uint32_t, uint32_t>> generated(edgeCount);
+        mt19937 edgeGenerator(97);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        for (auto& edge : generated) {
+            double u = unit(edgeGenerator);
+            edge.first = static_cast<uint32_t>(min<double>(vertexCount - 1, vertexCount * u * u * u));
+            edge.second = static_cast<uint32_t>(edgeGenerator() % vertexCount);
+        }
+        return generated;
+    });
+    cout << "Vertices: " << vertexCount << ", Edges: " << edgeCount << ", Threads: " << groupingThreads << endl;
 
-    for (int size : inputSizes) {
-        cout << "Input Size: " << size << endl;
-        vector<int> testData = generateScalabilityArray(size);
+    vector<pair<uint32_t, uint32_t>> sortedEdges = edges;
+    auto edgeSortStart = high_resolution_clock::now();
+    stable_sort(sortedEdges.begin(), sortedEdges.end(),
+        [](const pair<uint32_t, uint32_t>& a, const pair<uint32_t, uint32_t>& b) { return a.first < b.first; });
+    vector<size_t> expectedOffsets(vertexCount + 1, 0);
+    for (const auto& edge : sortedEdges) expectedOffsets[edge.first + 1]++;
+    for (size_t v = 0; v < vertexCount; v++) expectedOffsets[v + 1] += expectedOffsets[v];
+    duration<double, milli> edgeSortTime = high_resolution_clock::now() - edgeSortStart;
+    cout << "  stable_sort + Offsets:     " << fixed << setprecision(3) << edgeSortTime.count() << " ms" << endl;
 
-        cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-        cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-            << measureSortingTime(testData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-        cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-            << measureSortingTime(testData, radixSortLSD, "Radix Sort") << " ms" << endl;
-        cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-            << measureSortingTime(testData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-        cout << "  Bucket Sort:               " << fixed << setprecision(3)
-            << measureSortingTime(testData, bucketSort, "Bucket Sort") << " ms" << endl;
-        cout << endl;
+    auto matchesEdges = [&](const GroupedValues& csr, const vector<pair<uint32_t, uint32_t>>& expectedEdges) {
+        if (csr.offsets != expectedOffsets || csr.values.size() != expectedEdges.size()) return false;
+        for (size_t e = 0; e < expectedEdges.size(); e++) {
+            if (csr.values[e] != expectedEdges[e].second) return false;
+        }
+        return true;
+    };
+    vector<int> groupingThreadCounts = { 1 };
+    if (groupingThreads > 1) groupingThreadCounts.push_back(groupingThreads);
+    for (int threads : groupingThreadCounts) {
+        auto csrStart = high_resolution_clock::now();
+        GroupedValues csr = buildCSR(edges, vertexCount, threads);
+        duration<double, milli> csrTime = high_resolution_clock::now() - csrStart;
+        if (!matchesEdges(csr, sortedEdges)) cout << "ERROR: CSR groups differ from the stable edge sort!" << endl;
+        cout << "  buildCSR (" << threads << " thread" << (threads == 1 ? "):       " : "s):      ")
+            << fixed << setprecision(3) << csrTime.count() << " ms" << endl;
     }
 
+    sort(sortedEdges.begin(), sortedEdges.end());
+    auto neighbourSortStart = high_resolution_clock::now();
+    GroupedValues sortedCsr = buildCSR(edges, vertexCount, groupingThreads, true);
+    duration<double, milli> neighbourSortTime = high_resolution_clock::now() - neighbourSortStart;
+    if (!matchesEdges(sortedCsr, sortedEdges)) cout << "ERROR: CSR neighbours are not sorted!" << endl;
+    cout << "  buildCSR + Sorted Groups:  " << fixed << setprecision(3) << neighbourSortTime.count() << " ms" << endl;
+    cout << endl;
+
     // ========================================================================
-    // TEST 4: WORST CASE FOR BUCKET SORT
+    // TEST 26: QUANTILE SKETCH (KLL)
     // ========================================================================
-    cout << "\nTEST 4: WORST CASE FOR BUCKET SORT" << endl;
+    cout << "\nTEST 26: QUANTILE SKETCH (KLL)" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Test bucket sort with poor distribution (all in few buckets)" << endl;
-    cout << "Expected: Bucket sort degrades to O(n) due to uneven distribution" << endl;
-    cout << "         Other algorithms unaffected\n" << endl;
+    cout << "Purpose: Approximate percentiles in O(k) memory instead of sorting" << endl;
+    cout << "Expected: Rank error shrinks roughly as 1/k" << endl;
+    cout << "         Merging shard sketches is as accurate as one sketch\n" << endl;
 
-    int worstCaseSize = 5000;
-    cout << "Small Range [0, 10], Size: " << worstCaseSize << " (Worst Case)" << endl;
-    vector<int> worstCaseData = generateWorstCaseBucketSort(worstCaseSize);
+    int sketchStreamSize = 10000000;
+    vector<int> sketchStream = harnessDatasetCache().loadOrGenerate<int>(
+        "latency_n" + to_string(sketchStreamSize) + "_s98", [&]() {
+        vector<int> generated(sketchStreamSize);
+        mt19937 streamGenerator(98);
+        exponential_distribution<double> latency(1.0 / 100000);
+        for (int& value : generated) value = min(999999, static_cast<int>(latency(streamGenerator)));
+        return generated;
+    });
+    // Exact ranks from the counting sort
+    vector<int> exactStream = sketchStream;
+    countingSortNonStable(exactStream);
 
-    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-        << measureSortingTime(worstCaseData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-        << measureSortingTime(worstCaseData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-        << measureSortingTime(worstCaseData, radixSortLSD, "Radix Sort") << " ms" << endl;
-    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-        << measureSortingTime(worstCaseData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-    cout << "  Bucket Sort:               " << fixed << setprecision(3)
-        << measureSortingTime(worstCaseData, bucketSort, "Bucket Sort") << " ms" << endl;
+    // Worst rank error over the 1st..99th percentiles
+    auto maxRankError = [&](const KllSketch& sketch) {
+        double worst = 0;
+        for (int percentile = 1; percentile < 100; percentile++) {
+            double fraction = percentile / 100.0;
+            int estimate = sketch.quantile(fraction);
+            double lowRank = static_cast<double>(lower_bound(exactStream.begin(), exactStream.end(), estimate) -
+                exactStream.begin()) / sketchStreamSize;
+            double highRank = static_cast<double>(upper_bound(exactStream.begin(), exactStream.end(), estimate) -
+                exactStream.begin()) / sketchStreamSize;
+            worst = max(worst, max(lowRank - fraction, fraction - highRank));
+        }
+        return 100.0 * worst;
+    };
+    auto printSketch = [&](const string& label, const KllSketch& sketch, double updateNs) {
+        cout << "  " << left << setw(26) << label << right << setw(8) << sketch.retainedItems() << " items"
+            << fixed << setprecision(1) << setw(9) << sketch.memoryBytes() / 1024.0 << " KB"
+            << setprecision(3) << setw(9) << maxRankError(sketch) << "% max rank error"
+            << setprecision(2) << setw(8) << updateNs << " ns/item" << endl;
+    };
+
+    cout << "Exponential Stream: " << sketchStreamSize << " values (" << fixed << setprecision(1)
+        << sketchStreamSize * sizeof(int) / (1024.0 * 1024.0) << " MB raw)" << endl;
+    for (int accuracy : { 50, 200, 800 }) {
+        KllSketch sketch(accuracy);
+        auto updateStart = high_resolution_clock::now();
+        for (int value : sketchStream) sketch.update(value);
+        duration<double, nano> updateTime = high_resolution_clock::now() - updateStart;
+        printSketch("k = " + to_string(accuracy) + ":", sketch, updateTime.count() / sketchStreamSize);
+    }
+
+    // One sketch per shard, built on separate threads, then merged
+    int sketchShards = 8;
+    vector<KllSketch> shardSketches;
+    for (int s = 0; s < sketchShards; s++) shardSketches.push_back(KllSketch(200, 100 + s));
+    auto shardStart = high_resolution_clock::now();
+    runOnThreads(sketchShards, [&](int s) {
+        size_t begin = static_cast<size_t>(sketchStreamSize) * s / sketchShards;
+        size_t end = static_cast<size_t>(sketchStreamSize) * (s + 1) / sketchShards;
+        for (size_t i = begin; i < end; i++) shardSketches[s].update(sketchStream[i]);
+    });
+    KllSketch mergedSketch(200);
+    for (const KllSketch& shard : shardSketches) mergedSketch.merge(shard);
+    duration<double, nano> shardTime = high_resolution_clock::now() - shardStart;
+    if (mergedSketch.count() != static_cast<uint64_t>(sketchStreamSize)) {
+        cout << "ERROR: Merged sketch lost items!" << endl;
+    }
+    printSketch("k = 200, 8 shards merged:", mergedSketch, shardTime.count() / sketchStreamSize);
     cout << endl;
 
     // ========================================================================
-    // TEST 5: LARGE RANGE WITH FEW REPEATED VALUES
+    // TEST 27: FULL-DOMAIN COUNTING SORT (8/16-BIT KEYS)
     // ========================================================================
-    cout << "\nTEST 5: LARGE RANGE WITH FEW REPEATED VALUES" << endl;
+    cout << "\nTEST 27: FULL-DOMAIN COUNTING SORT (8/16-BIT KEYS)" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Test with sparse data over large range" << endl;
-    cout << "Expected: Counting/Pigeonhole sort inefficient (memory)" << endl;
-    cout << "         Radix/Bucket sort more efficient\n" << endl;
-
-    int largeRangeSize = 5000;
-    cout << "Range [0, 1000000], Size: " << largeRangeSize << endl;
-    vector<int> largeRangeData = generateLargeRangeFewRepeats(largeRangeSize);
+    cout << "Purpose: Sort byte and short arrays without a range scan" << endl;
+    cout << "Expected: Full-domain histogram is several times faster than the range scan" << endl;
+    cout << "         Lanes keep long runs of one byte from stalling the count\n" << endl;
 
-    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-        << measureSortingTime(largeRangeData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-        << measureSortingTime(largeRangeData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-        << measureSortingTime(largeRangeData, radixSortLSD, "Radix Sort") << " ms" << endl;
-    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-        << measureSortingTime(largeRangeData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-    cout << "  Bucket Sort:               " << fixed << setprecision(3)
-        << measureSortingTime(largeRangeData, bucketSort, "Bucket Sort") << " ms" << endl;
+    size_t smallKeyCount = 64000000;
+    string smallKeySuffix = "_n" + to_string(smallKeyCount);
+    {
+        vector<uint8_t> randomBytes = harnessDatasetCache().loadOrGenerate<uint8_t>("bytes" + smallKeySuffix + "_s99", [&]() {
+            mt19937 byteGenerator(99);
+            vector<uint8_t> generated(smallKeyCount);
+            for (uint8_t& key : generated) key = static_cast<uint8_t>(byteGenerator());
+            return generated;
+        });
+        runSmallKeyBenchmark("Random uint8_t", move(randomBytes));
+    }
+    {
+        // Long runs of the same byte, as in image masks
+        vector<uint8_t> runBytes = harnessDatasetCache().loadOrGenerate<uint8_t>("byteruns" + smallKeySuffix + "_s100", [&]() {
+            mt19937 byteGenerator(100);
+            vector<uint8_t> generated(smallKeyCount);
+            for (size_t i = 0; i < generated.size(); i += 4096) {
+                fill_n(generated.begin() + i, min<size_t>(4096, generated.size() - i),
+                    static_cast<uint8_t>(byteGenerator() % 4));
+            }
+            return generated;
+        });
+        runSmallKeyBenchmark("Run-heavy uint8_t", move(runBytes));
+    }
+    {
+        vector<uint16_t> randomShorts = harnessDatasetCache().loadOrGenerate<uint16_t>("shorts" + smallKeySuffix + "_s101", [&]() {
+            mt19937 shortGenerator(101);
+            vector<uint16_t> generated(smallKeyCount / 2);
+            for (uint16_t& key : generated) key = static_cast<uint16_t>(shortGenerator());
+            return generated;
+        });
+        runSmallKeyBenchmark("Random uint16_t", move(randomShorts));
+    }
     cout << endl;
 
     // ========================================================================
-    // TEST 6: MANY DUPLICATE VALUES
+    // TEST 28: BITSET SORT (DENSE UNIQUE KEYS)
     // ========================================================================
-    cout << "\nTEST 6: MANY DUPLICATE VALUES" << endl;
+    cout << "\nTEST 28: BITSET SORT (DENSE UNIQUE KEYS)" << endl;
     cout << "------------------------------------------------------------" << endl;
-    cout << "Purpose: Test with high duplicate rate" << endl;
-    cout << "Expected: Counting/Pigeonhole excel with duplicates" << endl;
-    cout << "         Stable sorts maintain relative order\n" << endl;
+    cout << "Purpose: Sort distinct IDs with one bit per possible value" << endl;
+    cout << "Expected: 32x less memory than counting sort, faster emission" << endl;
+    cout << "         Repeated keys or sparse ranges fall back to the byte radix sort\n" << endl;
 
-    int duplicateSize = 5000;
-    cout << "Only 10 Unique Values, Size: " << duplicateSize << endl;
-    vector<int> duplicateData = generateManyDuplicates(duplicateSize);
+    int idCount = 16000000;
+    for (int density : { 100, 25 }) {
+        // idCount distinct IDs drawn from a range density% full
+        int idRange = static_cast<int>(static_cast<int64_t>(idCount) * 100 / density);
+        vector<int> ids = harnessDatasetCache().loadOrGenerate<int>(
+            "ids_n" + to_string(idCount) + "_d" + to_string(density) + "_s100", [&]() {
+            mt19937 idGenerator(100);
+            vector<int> generated(idRange);
+            for (int i = 0; i < idRange; i++) generated[i] = 1000000 + i;
+            shuffle(generated.begin(), generated.end(), idGenerator);
+            generated.resize(idCount);
+            return generated;
+        });
 
-    cout << "  Counting Sort (Stable):    " << fixed << setprecision(3)
-        << measureSortingTime(duplicateData, countingSortStable, "Counting Sort Stable") << " ms" << endl;
-    cout << "  Counting Sort (Non-Stable): " << fixed << setprecision(3)
-        << measureSortingTime(duplicateData, countingSortNonStable, "Counting Sort Non-Stable") << " ms" << endl;
-    cout << "  Radix Sort (LSD):          " << fixed << setprecision(3)
-        << measureSortingTime(duplicateData, radixSortLSD, "Radix Sort") << " ms" << endl;
-    cout << "  Pigeonhole Sort:           " << fixed << setprecision(3)
-        << measureSortingTime(duplicateData, pigeonholeSort, "Pigeonhole Sort") << " ms" << endl;
-    cout << "  Bucket Sort:               " << fixed << setprecision(3)
-        << measureSortingTime(duplicateData, bucketSort, "Bucket Sort") << " ms" << endl;
+        cout << "Distinct IDs: " << idCount << ", Density: " << density << "% (range " << idRange << ")" << endl;
+        cout << "  Count Array: " << fixed << setprecision(1) << idRange * sizeof(int) / (1024.0 * 1024.0)
+            << " MB, Bitset: " << idRange / 8 / (1024.0 * 1024.0) << " MB" << endl;
+
+        vector<int> countingSorted = ids;
+        auto countingStart = high_resolution_clock::now();
+        countingSortNonStable(countingSorted);
+        duration<double, milli> countingTime = high_resolution_clock::now() - countingStart;
+
+        vector<int> bitsetSorted = ids;
+        auto bitsetStart = high_resolution_clock::now();
+        bool usedBitset = bitsetSort(bitsetSorted);
+        duration<double, milli> bitsetTime = high_resolution_clock::now() - bitsetStart;
+        if (!usedBitset) cout << "ERROR: Distinct IDs did not take the bitset path!" << endl;
+        if (bitsetSorted != countingSorted) cout << "ERROR: Bitset sort differs from counting sort!" << endl;
+
+        cout << "  countingSortNonStable:     " << fixed << setprecision(3) << countingTime.count() << " ms" << endl;
+        cout << "  bitsetSort:                " << bitsetTime.count() << " ms" << endl;
+    }
+
+    // One repeated ID: the popcount check catches it after the bit pass
+    {
+        vector<int> ids = harnessDatasetCache().loadOrGenerate<int>("ids_n" + to_string(idCount) + "_dup_s101", [&]() {
+            mt19937 idGenerator(101);
+            vector<int> generated(idCount);
+            for (int i = 0; i < idCount; i++) generated[i] = i;
+            shuffle(generated.begin(), generated.end(), idGenerator);
+            generated[idCount / 2] = generated[idCount / 3];
+            return generated;
+        });
+        vector<int> expected = ids;
+        countingSortNonStable(expected);
+
+        auto fallbackStart = high_resolution_clock::now();
+        bool usedBitset = bitsetSort(ids);
+        duration<double, milli> fallbackTime = high_resolution_clock::now() - fallbackStart;
+        if (usedBitset) cout << "ERROR: Duplicate ID was not detected!" << endl;
+        if (ids != expected) cout << "ERROR: Fallback result differs from counting sort!" << endl;
+        cout << "One Duplicate ID (" << idCount << " keys)" << endl;
+        cout << "  bitsetSort -> Fallback:    " << fixed << setprecision(3) << fallbackTime.count() << " ms" << endl;
+    }
+
+    // Sparse keys over the full int range: the density guard skips the bitset
+    {
+        vector<int> ids = harnessDatasetCache().load(NEGATIVE_HEAVY, idCount / 16, 100);
+        ids.push_back(numeric_limits<int>::min());
+        ids.push_back(numeric_limits<int>::max());
+        vector<int> expected = ids;
+        sort(expected.begin(), expected.end());
+
+        auto sparseStart = high_resolution_clock::now();
+        bool usedBitset = bitsetSort(ids);
+        duration<double, milli> sparseTime = high_resolution_clock::now() - sparseStart;
+        if (usedBitset) cout << "ERROR: Sparse IDs took the bitset path!" << endl;
+        if (ids != expected) cout << "ERROR: Sparse fallback result is not sorted!" << endl;
+        cout << "Sparse Full-Range IDs (" << ids.size() << " keys)" << endl;
+        cout << "  bitsetSort -> Fallback:    " << fixed << setprecision(3) << sparseTime.count() << " ms" << endl;
+    }
     cout << endl;
 
     // ========================================================================
@@ -572,6 +5400,7 @@ void runExperimentalTests() {
     cout << "\n2. Distribution Impact:" << endl;
     cout << "   - Bucket sort: Best on uniform, worst on skewed" << endl;
     cout << "   - Others: Generally distribution-independent" << endl;
+    cout << "   - Learned CDF buckets stay balanced on normal/skewed/exponential data" << endl;
 
     cout << "\n3. Scalability:" << endl;
     cout << "   - All show linear growth as expected" << endl;
@@ -590,13 +5419,365 @@ void runExperimentalTests() {
     cout << "   - Small range benefits all algorithms" << endl;
     cout << "   - Stable sorts preserve original order of duplicates" << endl;
 
+    cout << "\n7. Streaming Ingest:" << endl;
+    cout << "   - Writers only touch their own chunk until it fills" << endl;
+    cout << "   - Snapshots sort just the unsorted tail and merge it with the runs" << endl;
+
+    cout << "\n8. Search Index:" << endl;
+    cout << "   - Eytzinger layout keeps the top tree levels hot in cache" << endl;
+    cout << "   - Batched lookups overlap cache misses across queries" << endl;
+
+    cout << "\n9. Indirect Sort:" << endl;
+    cout << "   - Radix passes move 8-byte (key, index) pairs instead of records" << endl;
+    cout << "   - Each record moves once, so large records favour indirect sorting" << endl;
+
+    cout << "\n10. Columnar Sort:" << endl;
+    cout << "   - The key column is sorted once; payload columns only gather" << endl;
+    cout << "   - Cycle leaders are found once and reused for every column" << endl;
+
+    cout << "\n11. Stable In-Place Radix:" << endl;
+    cout << "   - Keeps stability with a sqrt(n) buffer instead of an n-sized copy" << endl;
+    cout << "   - Costs an extra log(n / B) factor in element moves per pass" << endl;
+
+    cout << "\n12. Parallel In-Place Radix:" << endl;
+    cout << "   - Speculative per-thread permutation needs no locks" << endl;
+    cout << "   - Repair rounds shrink quickly; memory stays O(threads x buckets)" << endl;
+
+    cout << "\n13. Memory Budget:" << endl;
+    cout << "   - Sorters reserve scratch before allocating it" << endl;
+    cout << "   - Refused reservations downgrade to the in-place stable radix sort" << endl;
+
+    cout << "\n14. Delta Merge:" << endl;
+    cout << "   - Only the delta is sorted; the base is merged from the back in place" << endl;
+    cout << "   - Sorted tombstones delete keys in one forward compaction pass" << endl;
+
+    cout << "\n15. Parallel Stable Merge Sort:" << endl;
+    cout << "   - Merge path splits every merge into equal per-thread shares" << endl;
+    cout << "   - Works for any comparator and preserves stability" << endl;
+
+    cout << "\n16. Input Shapes:" << endl;
+    cout << "   - Full-range and negative shapes rule out counting/pigeonhole/decimal radix" << endl;
+    cout << "   - Presorted and few-distinct shapes favour skipping radix passes" << endl;
+
+    cout << "\n17. Dataset Cache:" << endl;
+    cout << "   - Reloading a mapped binary file is far cheaper than regenerating" << endl;
+    cout << "   - Seeded keys make runs comparable across invocations" << endl;
+
+    cout << "\n18. Roofline Efficiency:" << endl;
+    cout << "   - Minimum time = modelled key traffic / measured copy bandwidth" << endl;
+    cout << "   - The gap to 100% is the headroom left in each engine" << endl;
+
+    cout << "\n19. Wide Fixed-Width Keys:" << endl;
+    cout << "   - MSD radix reads each key byte about once instead of per comparison" << endl;
+    cout << "   - Common prefixes (time-ordered UUIDs) are skipped in one scan" << endl;
+
+    cout << "\n20. Descending Order:" << endl;
+    cout << "   - Reversed cumulative counts or a complemented key sort descending directly" << endl;
+    cout << "   - Sorting ascending and reversing costs a pass and breaks stability" << endl;
+
+    cout << "\n21. Range Partitioning:" << endl;
+    cout << "   - Classification + one scatter is a fraction of a full sort" << endl;
+    cout << "   - Per-thread histograms give every thread private write offsets" << endl;
+
+    cout << "\n22. Distributed Sample Sort:" << endl;
+    cout << "   - Sampled splitters balance the key ranges across processes" << endl;
+    cout << "   - The all-to-all shuffle moves (P - 1) / P of the data; it dominates as P grows" << endl;
+
+    cout << "\n23. Sort Service:" << endl;
+    cout << "   - Clients pass a shared-memory descriptor; the daemon sorts their pages in place" << endl;
+    cout << "   - One engine for all clients avoids oversubscribing the cores" << endl;
+
+    cout << "\n24. Space-Filling Curves:" << endl;
+    cout << "   - Codes are computed once; the radix engine sorts (code, index) pairs" << endl;
+    cout << "   - Hilbert order keeps consecutive points closer than Morton order" << endl;
+
+    cout << "\n25. Grouping by Key:" << endl;
+    cout << "   - CSR offsets are the cumulative counts of a stable counting sort" << endl;
+    cout << "   - Per-thread histograms keep groups in edge order without locks" << endl;
+
+    cout << "\n26. Quantile Sketch:" << endl;
+    cout << "   - A few KB answer every percentile within about 1/k rank error" << endl;
+    cout << "   - Shard sketches merge level by level with no loss of accuracy" << endl;
+
+    cout << "\n27. Full-Domain Counting Sort:" << endl;
+    cout << "   - 8/16-bit keys need no min/max scan; the histogram stays in cache" << endl;
+    cout << "   - The rewrite is a memset per value; the counting pass sets the pace" << endl;
+
+    cout << "\n28. Bitset Sort:" << endl;
+    cout << "   - Distinct dense IDs need one bit per value instead of one int" << endl;
+    cout << "   - Duplicates (popcount check) and sparse ranges fall back to byte radix" << endl;
+
     cout << "\n============================================" << endl;
 }
 
+// ============================================================================
+// KERNEL MICROBENCHMARKS
+// ============================================================================
+// Times the building blocks of the engines in isolation: the histogram count
+// loop, the prefix sum, the stable scatter, pigeonhole placement and bucket
+// classification. Each kernel runs once to warm up and then REPETITIONS
+// times; the median is reported with the minimum and the spread (median
+// absolute deviation as a percentage of the median).
+// Run with: ./sorting_demo --microbench
+
+struct TimingStatistics {
+    double medianNs;
+    double minimumNs;
+    double spreadPercent;
+};
+
+template<typename Kernel>
+TimingStatistics timeKernel(Kernel kernel, size_t elementsPerRun, int repetitions) {
+    kernel();
+    vector<double> samples;
+    for (int r = 0; r < repetitions; r++) {
+        auto startTime = high_resolution_clock::now();
+        kernel();
+        duration<double, nano> elapsed = high_resolution_clock::now() - startTime;
+        samples.push_back(elapsed.count() / max<size_t>(1, elementsPerRun));
+    }
+    sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+    vector<double> deviations;
+    for (double sample : samples) {
+        deviations.push_back(fabs(sample - median));
+    }
+    sort(deviations.begin(), deviations.end());
+    TimingStatistics statistics;
+    statistics.medianNs = median;
+    statistics.minimumNs = samples.front();
+    statistics.spreadPercent = median > 0 ? 100.0 * deviations[deviations.size() / 2] / median : 0.0;
+    return statistics;
+}
+
+void printKernelTiming(const string& kernelName, int size, const string& radix, const TimingStatistics& statistics) {
+    cout << "  " << left << setw(24) << kernelName << setw(10) << size << setw(8) << radix << right
+        << fixed << setprecision(3) << setw(10) << statistics.medianNs << setw(10) << statistics.minimumNs
+        << setprecision(1) << setw(9) << statistics.spreadPercent << "%" << endl;
+}
+
+void runKernelMicrobenchmarks() {
+    const int REPETITIONS = 15;
+    vector<int> sizes = { 1000, 100000, 1000000 };
+    vector<int> radixBits = { 4, 8, 11, 16 };
+    volatile long long sink = 0;
+
+    cout << "============================================" << endl;
+    cout << "   KERNEL MICROBENCHMARKS (ns/element)" << endl;
+    cout << "============================================" << endl;
+    cout << "  " << left << setw(24) << "Kernel" << setw(10) << "Size" << setw(8) << "Radix" << right
+        << setw(10) << "Median" << setw(10) << "Min" << setw(10) << "Spread" << endl;
+
+    for (int size : sizes) {
+        vector<int> input = harnessDatasetCache().load(NEGATIVE_HEAVY, size, 88);
+        for (int& value : input) {
+            value = static_cast<int>(radixKeyOf(value) >> 1);
+        }
+        vector<int> output(size);
+
+        // Decimal digit kernels exactly as countingSortByDigit runs them
+        {
+            const int BASE = 10;
+            int digitPosition = 1000;
+            vector<int> countArray(BASE);
+            printKernelTiming("Count (decimal digit)", size, "10", timeKernel([&]() {
+                fill(countArray.begin(), countArray.end(), 0);
+                for (int value : input) countArray[(value / digitPosition) % BASE]++;
+                sink += countArray[0];
+            }, size, REPETITIONS));
+            printKernelTiming("Scatter (decimal digit)", size, "10", timeKernel([&]() {
+                fill(countArray.begin(), countArray.end(), 0);
+                for (int value : input) countArray[(value / digitPosition) % BASE]++;
+                for (int i = 1; i < BASE; i++) countArray[i] += countArray[i - 1];
+                for (int i = size - 1; i >= 0; i--) {
+                    output[--countArray[(input[i] / digitPosition) % BASE]] = input[i];
+                }
+                sink += output[0];
+            }, size, REPETITIONS));
+        }
+
+        for (int bits : radixBits) {
+            const int BASE = 1 << bits;
+            const unsigned MASK = BASE - 1;
+            string radixLabel = to_string(BASE);
+            vector<size_t> countArray(BASE);
+            auto digitOf = [&](int value) { return static_cast<unsigned>(value) & MASK; };
+
+            printKernelTiming("Count", size, radixLabel, timeKernel([&]() {
+                fill(countArray.begin(), countArray.end(), 0);
+                for (int value : input) countArray[digitOf(value)]++;
+                sink += countArray[0];
+            }, size, REPETITIONS));
+
+            // Prefix sum is timed per bucket, not per element. It reads the
+            // counts and writes a scratch array, so every repetition scans the
+            // same counts instead of the previous repetition's offsets.
+            vector<size_t> offsets(BASE);
+            printKernelTiming("Prefix Sum (per bucket)", size, radixLabel, timeKernel([&]() {
+                size_t offset = 0;
+                for (int digit = 0; digit < BASE; digit++) {
+                    offsets[digit] = offset;
+                    offset += countArray[digit];
+                }
+                sink += offsets[BASE - 1];
+            }, BASE, REPETITIONS));
+
+            printKernelTiming("Scatter", size, radixLabel, timeKernel([&]() {
+                size_t offset = 0;
+                for (int digit = 0; digit < BASE; digit++) {
+                    offsets[digit] = offset;
+                    offset += countArray[digit];
+                }
+                for (int value : input) output[offsets[digitOf(value)]++] = value;
+                sink += output[0];
+            }, size, REPETITIONS));
+
+            printKernelTiming("Pigeonhole Placement", size, radixLabel, timeKernel([&]() {
+                vector<vector<int>> pigeonholes(BASE);
+                for (int value : input) pigeonholes[digitOf(value)].push_back(value);
+                sink += pigeonholes[0].size();
+            }, size, REPETITIONS));
+
+            // Bucket index computation as bucketSort does it, BASE buckets
+            int minValue = *min_element(input.begin(), input.end());
+            int maxValue = *max_element(input.begin(), input.end());
+            long long range = static_cast<long long>(maxValue) - minValue + 1;
+            vector<int> bucketIndex(size);
+            printKernelTiming("Bucket Classification", size, radixLabel, timeKernel([&]() {
+                for (int i = 0; i < size; i++) {
+                    bucketIndex[i] = static_cast<int>((static_cast<long long>(input[i]) - minValue) * (BASE - 1) / range);
+                }
+                sink += bucketIndex[0];
+            }, size, REPETITIONS));
+        }
+        cout << endl;
+    }
+}
+
+// ============================================================================
+// STARTUP AUTOTUNER
+// ============================================================================
+// Sweeps the TuningProfile parameters on this machine and persists the
+// fastest values, so later runs (and every engine that reads tuningProfile())
+// pick them up without recompiling. Each candidate is timed as the median of
+// AUTOTUNE_REPETITIONS sorts of the same seeded input; a parameter is only
+// changed when a candidate beats the current value by more than 3%, which
+// keeps noisy machines on the defaults.
+// Run with: ./sorting_demo --autotune
+
+const int AUTOTUNE_REPETITIONS = 7;
+
+template<typename SortFunction>
+double medianSortMs(const vector<int>& input, SortFunction sortFunc) {
+    vector<double> samples;
+    for (int r = 0; r < AUTOTUNE_REPETITIONS; r++) {
+        vector<int> array = input;
+        auto startTime = high_resolution_clock::now();
+        sortFunc(array);
+        duration<double, milli> elapsed = high_resolution_clock::now() - startTime;
+        samples.push_back(elapsed.count());
+    }
+    sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// Times every candidate after applying it with setParameter and returns the
+// winner; the current value is the baseline and is kept unless clearly beaten
+template<typename Value, typename Apply, typename Measure>
+Value pickFastest(const string& parameterName, Value currentValue, const vector<Value>& candidates,
+    Apply setParameter, Measure measure) {
+    setParameter(currentValue);
+    double bestMs = measure();
+    Value bestValue = currentValue;
+    cout << "  " << left << setw(26) << parameterName << right;
+    for (const Value& candidate : candidates) {
+        setParameter(candidate);
+        double candidateMs = measure();
+        cout << " " << candidate << ":" << fixed << setprecision(2) << candidateMs;
+        if (candidateMs < bestMs * 0.97) {
+            bestMs = candidateMs;
+            bestValue = candidate;
+        }
+    }
+    setParameter(bestValue);
+    cout << "  -> " << bestValue << endl;
+    return bestValue;
+}
+
+TuningProfile runAutotune(const string& profilePath = tuningProfilePath()) {
+    const int SIZE = 200000;
+    TuningProfile& profile = tuningProfile();
+
+    cout << "============================================" << endl;
+    cout << "   AUTOTUNING (median ms per candidate)" << endl;
+    cout << "============================================" << endl;
+
+    // Bucket sort on uniform and normal keys; both shapes weigh equally
+    vector<int> uniformKeys = generateVaryingRangeArray(SIZE, 10 * SIZE);
+    vector<int> normalKeys = generateDistributionArray(SIZE, NORMAL);
+    auto bucketTime = [&]() {
+        return medianSortMs(uniformKeys, bucketSort) + medianSortMs(normalKeys, bucketSort);
+    };
+    // The cutoff goes first: with duplicate-heavy keys an unbounded insertion
+    // sort dominates every load factor measurement
+    pickFastest<size_t>("bucketInsertionCutoff", profile.bucketInsertionCutoff, { 16, 32, 64, 128, 256 },
+        [&](size_t value) { profile.bucketInsertionCutoff = value; }, bucketTime);
+    pickFastest<int>("bucketLoadFactor", profile.bucketLoadFactor, { 1, 2, 4, 8, 16 },
+        [&](int value) { profile.bucketLoadFactor = value; }, bucketTime);
+
+    auto learnedTime = [&]() {
+        return medianSortMs(uniformKeys, bucketSortLearnedCDF) + medianSortMs(normalKeys, bucketSortLearnedCDF);
+    };
+    pickFastest<size_t>("learnedInsertionCutoff", profile.learnedInsertionCutoff, { 16, 32, 64, 128, 256 },
+        [&](size_t value) { profile.learnedInsertionCutoff = value; }, learnedTime);
+    pickFastest<int>("learnedBucketLoadFactor", profile.learnedBucketLoadFactor, { 1, 2, 4, 8, 16 },
+        [&](int value) { profile.learnedBucketLoadFactor = value; }, learnedTime);
+
+    // Digit width of the LSD engine on full-range signed keys
+    vector<int> fullRangeKeys = harnessDatasetCache().load(NEGATIVE_HEAVY, 1000000, 90);
+    auto signedKey = [](int value) { return radixKeyOf(value); };
+    pickFastest<int>("radixDigitBits", profile.radixDigitBits, { 4, 6, 8, 11, 16 },
+        [&](int value) { profile.radixDigitBits = value; },
+        [&]() { return medianSortMs(fullRangeKeys, [&](vector<int>& array) { radixSortByteLSD(array, signedKey); }); });
+
+    // Counting vs radix crossover for sortBatch: the largest range/n ratio
+    // at which counting sort is still the faster of the two
+    double crossover = 0.5;
+    cout << "  " << left << setw(26) << "countingRangeFactor" << right;
+    for (double factor : { 1.0, 2.0, 4.0, 8.0, 16.0, 32.0 }) {
+        vector<int> batch = generateVaryingRangeArray(SIZE, static_cast<int>(factor * SIZE) - 1);
+        double countingMs = medianSortMs(batch, countingSortNonStable);
+        double radixMs = medianSortMs(batch, [&](vector<int>& array) { radixSortByteLSD(array, signedKey); });
+        cout << " " << factor << ":" << fixed << setprecision(2) << countingMs << "/" << radixMs;
+        if (countingMs < radixMs) crossover = factor;
+    }
+    profile.countingRangeFactor = crossover;
+    cout << "  -> " << crossover << endl;
+
+    if (saveTuningProfile(profile, profilePath)) {
+        cout << "Profile written to " << profilePath << endl;
+    }
+    else {
+        cout << "ERROR: could not write tuning profile to " << profilePath << endl;
+    }
+    return profile;
+}
+
 // ============================================================================
 // MAIN FUNCTION - DEMONSTRATES ALL SORTING ALGORITHMS
 // ============================================================================
-int main() {
+int main(int argc, char* argv[]) {
+    // Kernel-level microbenchmarks replace the demonstration when requested
+    if (argc > 1 && string(argv[1]) == "--microbench") {
+        runKernelMicrobenchmarks();
+        return 0;
+    }
+    // The autotuner measures and persists the tuning profile, then exits
+    if (argc > 1 && string(argv[1]) == "--autotune") {
+        runAutotune();
+        return 0;
+    }
+
     cout << "============================================" << endl;
     cout << "   SORTING ALGORITHMS DEMONSTRATION" << endl;
     cout << "============================================" << endl << endl;
@@ -646,6 +5827,15 @@ int main() {
     printArray(testArray5, "Sorted  ");
     cout << endl;
 
+    // Test 6: Bucket Sort (Learned CDF)
+    cout << "6. BUCKET SORT (LEARNED CDF)" << endl;
+    cout << "----------------------------" << endl;
+    vector<int> testArray6 = generateTestArray();
+    printArray(testArray6, "Original");
+    bucketSortLearnedCDF(testArray6);
+    printArray(testArray6, "Sorted  ");
+    cout << endl;
+
     cout << "============================================" << endl;
     cout << "   ALL SORTING ALGORITHMS COMPLETED" << endl;
     cout << "============================================" << endl;